@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include <hwloc.h>
 #include <signal.h>
@@ -15,10 +16,18 @@
 
 #include <boost/program_options.hpp>
 
+#include "access/system/AdmissionControl.h"
+#include "access/system/CostModel.h"
+#include "access/system/QueryCancellation.h"
+#include "access/system/ResultCursors.h"
 #include "helper/HwlocHelper.h"
 #include "net/AsyncConnection.h"
+#include "net/EventLoopGroup.h"
 #include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "io/VersionCollector.h"
 #include "taskscheduler/SharedScheduler.h"
+#include "taskscheduler/FairSharePriorityScheduler.h"
 
 namespace po = boost::program_options;
 using namespace hyrise;
@@ -29,9 +38,11 @@ namespace  {
 
 const char *PID_FILE = "./hyrise_server.pid";
 const char *PORT_FILE = "./hyrise_server.port";
+const char *COST_MODEL_FILE = "./hyrise_cost_models.json";
 const size_t DEFAULT_PORT = 5000;
 // default maximum task size. 0 is disabled.
 const size_t DEFAULT_MTS = 0;
+const size_t DEFAULT_EVENT_LOOPS = 1;
 
 
 LoggerPtr logger(Logger::getLogger("hyrise"));
@@ -42,10 +53,10 @@ LoggerPtr logger(Logger::getLogger("hyrise"));
 /// we initialize
 class PortResource {
  public:
-  PortResource(size_t start, size_t end, ebb_server& s) : _current(0) {
+  PortResource(size_t start, size_t end, net::EventLoopGroup& loops) : _current(0) {
     assert((start < end) && "start must be smaller than end");
     for (size_t current = start; current < end; ++current) {
-      if (ebb_server_listen_on_port(&s, current) != -1) {
+      if (loops.listen(current)) {
           _current = current;
           break;
       } else {
@@ -129,6 +140,19 @@ int main(int argc, char *argv[]) {
   std::string logPropertyFile;
   std::string scheduler_name;
   size_t maxTaskSize;
+  size_t event_loops;
+  std::vector<int> event_loop_cores;
+  std::vector<std::string> max_queries;
+  std::vector<std::string> cpu_shares;
+  size_t aging_threshold;
+  access::AdmissionLimits admission;
+  size_t admission_timeout;
+  size_t query_deadline;
+  size_t gc_interval;
+  size_t gc_rows;
+  size_t snapshot_timeout;
+  size_t max_cursors;
+  std::string cost_model_file;
 
   // Program Options
   po::options_description desc("Allowed Parameters");
@@ -137,7 +161,22 @@ int main(int argc, char *argv[]) {
   ("logdef,l", po::value<std::string>(&logPropertyFile)->default_value("build/log.properties"), "Log4CXX Log Properties File")
   ("maxTaskSize,m", po::value<size_t>(&maxTaskSize)->default_value(DEFAULT_MTS), "Maximum task size used in dynamic parallelization scheduler. Use 0 for unbounded task run time.")
   ("scheduler,s", po::value<std::string>(&scheduler_name)->default_value("ThreadPerTaskScheduler"), "Name of the scheduler to use")
-  ("threads,t", po::value<int>(&worker_threads)->default_value(getNumberOfCoresOnSystem()), "Number of worker threads for scheduler (only relevant for scheduler with fixed number of threads)");
+  ("threads,t", po::value<int>(&worker_threads)->default_value(getNumberOfCoresOnSystem()), "Number of worker threads for scheduler (only relevant for scheduler with fixed number of threads)")
+  ("eventLoops,e", po::value<size_t>(&event_loops)->default_value(DEFAULT_EVENT_LOOPS), "Number of network event loop threads, each with its own SO_REUSEPORT socket")
+  ("eventLoopCores", po::value<std::vector<int>>(&event_loop_cores)->multitoken(), "Cores to pin the event loop threads to, one per loop")
+  ("cpuShares", po::value<std::vector<std::string>>(&cpu_shares)->multitoken(), "FairSharePriorityScheduler: CPU share of a priority, given as priority=share; priorities without one get share 1")
+  ("agingThreshold", po::value<size_t>(&aging_threshold)->default_value(100), "FairSharePriorityScheduler: milliseconds after which a waiting task runs regardless of the shares. Use 0 to disable.")
+  ("maxQueries", po::value<std::vector<std::string>>(&max_queries)->multitoken(), "Admission control: maximum number of concurrent queries of a priority, given as priority=limit")
+  ("maxSessionQueries", po::value<size_t>(&admission.queriesPerSession)->default_value(0), "Admission control: maximum number of concurrent queries per session. Use 0 for unlimited.")
+  ("maxTasks", po::value<size_t>(&admission.tasks)->default_value(0), "Admission control: maximum number of operator tasks of all running queries. Use 0 for unlimited.")
+  ("admissionQueue", po::value<size_t>(&admission.queueLength)->default_value(1024), "Admission control: maximum number of queries waiting for admission")
+  ("admissionTimeout", po::value<size_t>(&admission_timeout)->default_value(10000), "Admission control: milliseconds a query waits for admission before it is rejected")
+  ("queryDeadline", po::value<size_t>(&query_deadline)->default_value(0), "Milliseconds after which queries without a deadline are cancelled. Use 0 for no deadline.")
+  ("gcInterval", po::value<size_t>(&gc_interval)->default_value(1000), "Milliseconds between removing row versions no snapshot can see from the deltas. Use 0 to disable.")
+  ("gcMinRows", po::value<size_t>(&gc_rows)->default_value(io::VersionCollector::defaultMinimumRows), "Minimum number of reclaimable rows for compacting a delta")
+  ("snapshotTimeout", po::value<size_t>(&snapshot_timeout)->default_value(600), "Seconds after which the snapshot of a transaction that did not read meanwhile is released. Use 0 to keep it until the transaction ends.")
+  ("maxCursors", po::value<size_t>(&max_cursors)->default_value(access::ResultCursors::defaultMaxCursors), "Maximum number of open result cursors. Use 0 for unlimited.")
+  ("costModels", po::value<std::string>(&cost_model_file)->default_value(COST_MODEL_FILE), "File the cost models of dynamic parallelization are loaded from and saved to. Use an empty name to not persist them.");
   po::variables_map vm;
 
   try {
@@ -166,23 +205,47 @@ int main(int argc, char *argv[]) {
 #endif
 
   taskscheduler::SharedScheduler::getInstance().init(scheduler_name, worker_threads, maxTaskSize);
+  if (auto fairScheduler = std::dynamic_pointer_cast<taskscheduler::FairSharePriorityScheduler>(taskscheduler::SharedScheduler::getInstance().getScheduler())) {
+    for (const auto& share : cpu_shares) {
+      const auto separator = share.find('=');
+      if (separator == std::string::npos) {
+        std::cerr << "cpuShares expects priority=share, got " << share << std::endl;
+        return EXIT_FAILURE;
+      }
+      fairScheduler->setShare(std::stoi(share.substr(0, separator)), std::stod(share.substr(separator + 1)));
+    }
+    fairScheduler->setAgingThreshold(std::chrono::milliseconds(aging_threshold));
+  }
 
-  // Main Server Loop
-  struct ev_loop *loop = ev_default_loop(0);
-  ebb_server server;
-  // Initialize server based on libev event loop
-  ebb_server_init(&server, loop);
-
-
-  // Define handler for ebb
-  server.new_connection = net::new_connection;
+  for (const auto& limit : max_queries) {
+    const auto separator = limit.find('=');
+    if (separator == std::string::npos) {
+      std::cerr << "maxQueries expects priority=limit, got " << limit << std::endl;
+      return EXIT_FAILURE;
+    }
+    admission.queriesPerPriority[std::stoi(limit.substr(0, separator))] = std::stoul(limit.substr(separator + 1));
+  }
+  admission.timeout = std::chrono::milliseconds(admission_timeout);
+  access::AdmissionControl::getInstance().setLimits(admission);
+  access::RunningQueries::getInstance().setDefaultDeadline(std::chrono::milliseconds(query_deadline));
+  tx::TransactionManager::getInstance().setSnapshotTimeout(std::chrono::seconds(snapshot_timeout));
+  access::ResultCursors::getInstance().setMaxCursors(max_cursors);
+  io::VersionCollector::getInstance().setMinimumRows(gc_rows);
+  io::VersionCollector::getInstance().start(std::chrono::milliseconds(gc_interval));
+  if (!cost_model_file.empty() && access::CostModels::getInstance().load(cost_model_file))
+    LOG4CXX_INFO(logger, "Loaded cost models from " << cost_model_file);
+
+  // Main Server Loops, based on libev event loops
+  net::EventLoopGroup loops(event_loops, event_loop_cores);
 
   PidFile pi;
-  PortResource pa(port, port+100, server);
+  PortResource pa(port, port+100, loops);
 
   LOG4CXX_INFO(logger, "Started server on port " << pa.getPort());
-  ev_loop(loop, 0);
+  loops.run();
   LOG4CXX_INFO(logger, "Stopping Server...");
-  ev_default_destroy ();
+  io::VersionCollector::getInstance().stop();
+  if (!cost_model_file.empty())
+    access::CostModels::getInstance().save(cost_model_file);
   return 0;
 }
@@ -0,0 +1,68 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+
+#include "helper/PositionsSetOperations.h"
+
+using hyrise::storage::pos_t;
+using hyrise::storage::pos_list_t;
+
+namespace {
+
+pos_list_t random_positions(size_t count, size_t universe, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<pos_t> dist(0, universe - 1);
+  pos_list_t result(count);
+  std::generate(result.begin(), result.end(), [&] () { return dist(gen); });
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+void check(const pos_list_t& a, const pos_list_t& b) {
+  pos_list_t expected_intersection, expected_union, intersection, union_result;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_intersection));
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_union));
+
+  hyrise::helper::intersect_sorted(a, b, intersection);
+  hyrise::helper::unite_sorted(a, b, union_result);
+  ASSERT_EQ(expected_intersection, intersection);
+  ASSERT_EQ(expected_union, union_result);
+}
+
+}
+
+TEST(PositionsSetOperationsTest, empty_inputs) {
+  check({}, {});
+  check({1, 2, 3}, {});
+  check({}, {4, 5});
+}
+
+TEST(PositionsSetOperationsTest, similar_sizes) {
+  for (unsigned seed = 0; seed < 10; ++seed) {
+    check(random_positions(1000 + seed, 5000, seed), random_positions(1200, 5000, seed + 100));
+  }
+}
+
+TEST(PositionsSetOperationsTest, skewed_sizes) {
+  check(random_positions(10, 100000, 1), random_positions(50000, 100000, 2));
+  check(random_positions(50000, 100000, 3), random_positions(7, 100000, 4));
+}
+
+TEST(PositionsSetOperationsTest, disjoint_and_adjacent_runs) {
+  pos_list_t a(1000), b(1000);
+  std::iota(a.begin(), a.end(), 0);
+  std::iota(b.begin(), b.end(), 1000);
+  check(a, b);
+  check(b, a);
+}
+
+TEST(PositionsSetOperationsTest, large_inputs_are_partitioned) {
+  const size_t size = hyrise::helper::parallelSetOperationThreshold;
+  check(random_positions(size, size * 3, 5), random_positions(size / 2, size * 3, 6));
+}
+
@@ -0,0 +1,71 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <vector>
+
+#include "access/system/AdmissionControl.h"
+
+namespace hyrise {
+namespace access {
+
+class AdmissionControlTests : public AccessTest {
+ protected:
+  AdmissionLimits _previous;
+
+  virtual void SetUp() {
+    AccessTest::SetUp();
+    _previous = AdmissionControl::getInstance().getLimits();
+  }
+
+  virtual void TearDown() {
+    AdmissionControl::getInstance().setLimits(_previous);
+    AccessTest::TearDown();
+  }
+};
+
+TEST_F(AdmissionControlTests, waits_for_running_query) {
+  auto &control = AdmissionControl::getInstance();
+  AdmissionLimits limits;
+  limits.queriesPerPriority[5] = 1;
+  control.setLimits(limits);
+
+  std::vector<std::unique_ptr<AdmissionTicket>> tickets;
+  std::vector<std::string> rejections;
+  auto admitted = [&tickets] (std::unique_ptr<AdmissionTicket> ticket) { tickets.push_back(std::move(ticket)); };
+  auto rejected = [&rejections] (const std::string &message) { rejections.push_back(message); };
+
+  control.admit(5, 0, 1, admitted, rejected);
+  control.admit(5, 0, 1, admitted, rejected);
+  // Other priorities are not limited
+  control.admit(6, 0, 1, admitted, rejected);
+  ASSERT_EQ(2u, tickets.size());
+  ASSERT_EQ(1u, control.waiting());
+
+  tickets.front().reset();
+  ASSERT_EQ(3u, tickets.size());
+  ASSERT_EQ(0u, control.waiting());
+  ASSERT_TRUE(rejections.empty());
+  tickets.clear();
+  ASSERT_EQ(0u, control.running());
+}
+
+TEST_F(AdmissionControlTests, rejects_when_queue_full) {
+  auto &control = AdmissionControl::getInstance();
+  AdmissionLimits limits;
+  limits.queriesPerSession = 1;
+  limits.queueLength = 0;
+  control.setLimits(limits);
+
+  std::vector<std::unique_ptr<AdmissionTicket>> tickets;
+  size_t rejections = 0;
+  auto admitted = [&tickets] (std::unique_ptr<AdmissionTicket> ticket) { tickets.push_back(std::move(ticket)); };
+  auto rejected = [&rejections] (const std::string &message) { ++rejections; };
+
+  control.admit(5, 42, 1, admitted, rejected);
+  control.admit(5, 42, 1, admitted, rejected);
+  ASSERT_EQ(1u, tickets.size());
+  ASSERT_EQ(1u, rejections);
+}
+
+}
+}
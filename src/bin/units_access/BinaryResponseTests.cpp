@@ -0,0 +1,76 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <cstring>
+
+#include "access/system/BinaryResponse.h"
+#include "io/shortcuts.h"
+#include "storage/AbstractTable.h"
+
+namespace hyrise {
+namespace access {
+
+class BinaryResponseTests : public AccessTest {
+ protected:
+  template <typename T>
+  T read(const std::string &data, size_t &pos) {
+    T value;
+    memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  void align(size_t &pos) {
+    pos = (pos + 7) & ~static_cast<size_t>(7);
+  }
+};
+
+TEST_F(BinaryResponseTests, encode_companies) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  Json::Value metadata;
+  metadata["real_size"] = 4;
+
+  // rows 1 and 2
+  const std::string data = generateBinaryResponse(t, metadata, 2, 1);
+  size_t pos = 0;
+  ASSERT_EQ("HYRC", data.substr(0, 4));
+  pos += 4;
+  ASSERT_EQ(binaryResponseVersion, read<uint32_t>(data, pos));
+  const uint32_t metadataLength = read<uint32_t>(data, pos);
+  ASSERT_EQ(2u, read<uint32_t>(data, pos));
+  ASSERT_EQ(2u, read<uint64_t>(data, pos));
+
+  Json::Value parsed;
+  Json::Reader reader;
+  ASSERT_TRUE(reader.parse(data.substr(pos, metadataLength), parsed));
+  ASSERT_EQ(4, parsed["real_size"].asInt());
+  pos += metadataLength;
+  align(pos);
+
+  ASSERT_EQ(static_cast<uint32_t>(BinaryInt), read<uint32_t>(data, pos));
+  uint32_t nameLength = read<uint32_t>(data, pos);
+  ASSERT_EQ("company_id", data.substr(pos, nameLength));
+  pos += nameLength;
+  align(pos);
+
+  ASSERT_EQ(static_cast<uint32_t>(BinaryString), read<uint32_t>(data, pos));
+  nameLength = read<uint32_t>(data, pos);
+  ASSERT_EQ("company_name", data.substr(pos, nameLength));
+  pos += nameLength;
+  align(pos);
+
+  ASSERT_EQ(2, read<hyrise_int_t>(data, pos));
+  ASSERT_EQ(3, read<hyrise_int_t>(data, pos));
+
+  const uint64_t first = read<uint64_t>(data, pos);
+  const uint64_t second = read<uint64_t>(data, pos);
+  const uint64_t end = read<uint64_t>(data, pos);
+  ASSERT_EQ("Microsoft", data.substr(pos + first, second - first));
+  ASSERT_EQ("SAP AG", data.substr(pos + second, end - second));
+  pos += end;
+  align(pos);
+  ASSERT_EQ(data.size(), pos);
+}
+
+}
+}
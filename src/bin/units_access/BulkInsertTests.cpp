@@ -0,0 +1,62 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/BulkInsert.h"
+#include "access/system/BinaryResponse.h"
+#include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class BulkInsertTests : public AccessTest {};
+
+TEST_F(BulkInsertTests, insert_csv) {
+  auto table = io::Loader::shortcuts::load("test/insert_one.tbl");
+  auto ctx = tx::TransactionManager::getInstance().buildContext();
+
+  BulkInsert bi;
+  bi.setTXContext(ctx);
+  bi.addInput(table);
+  bi.setCSV("2|3\r\n\n\"4\"|5\n", '|');
+  bi.execute();
+
+  const auto &store = std::dynamic_pointer_cast<const storage::Store>(bi.getResultTable());
+  ASSERT_EQ(2u, bi.getInsertedRows());
+  ASSERT_EQ(2u, store->getDeltaTable()->size());
+  EXPECT_EQ(2, store->getDeltaTable()->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(5, store->getDeltaTable()->getValue<hyrise_int_t>(1, 1));
+  EXPECT_EQ(ctx.tid, store->tid(store->getMainTable()->size()));
+  EXPECT_EQ(2u, tx::TransactionManager::getInstance()[ctx.tid].getInserted(store).size());
+}
+
+TEST_F(BulkInsertTests, reject_malformed_csv) {
+  auto table = io::Loader::shortcuts::load("test/insert_one.tbl");
+
+  BulkInsert bi;
+  bi.setTXContext(tx::TransactionManager::getInstance().buildContext());
+  bi.addInput(table);
+  bi.setCSV("2|3|4\n");
+  EXPECT_THROW(bi.execute(), std::runtime_error);
+
+  bi.setCSV("2|x\n");
+  EXPECT_THROW(bi.execute(), std::runtime_error);
+}
+
+TEST_F(BulkInsertTests, insert_binary_result) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto table = io::Loader::shortcuts::load("test/tables/companies.tbl");
+
+  BulkInsert bi;
+  bi.setTXContext(tx::TransactionManager::getInstance().buildContext());
+  bi.addInput(table);
+  bi.setBinary(generateBinaryResponse(companies, Json::Value(), 0, 0));
+  bi.execute();
+
+  const auto &store = std::dynamic_pointer_cast<const storage::Store>(bi.getResultTable());
+  ASSERT_EQ(companies->size(), bi.getInsertedRows());
+  ASSERT_TABLE_EQUAL(store->getDeltaTable(), companies);
+}
+
+}
+}
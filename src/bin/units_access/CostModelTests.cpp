@@ -0,0 +1,96 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <cstdio>
+#include <fstream>
+
+#include "access/Barrier.h"
+#include "access/TableScan.h"
+#include "access/expressions/pred_EqualsExpression.h"
+#include "access/system/CostModel.h"
+#include "helper/make_unique.h"
+#include "io/shortcuts.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class CostModelTests : public AccessTest {
+ public:
+  const CostModel::parameters_t prior {{1.0, 2.0, 0.5, 1.0}};
+  const CostModel::parameters_t actual {{4.0, 10.0, 0.25, 3.0}};
+
+  double mts(double size, size_t instances) {
+    return (actual[0] * size + actual[1]) / instances + actual[2] * size + actual[3];
+  }
+
+  void TearDown() {
+    CostModels::getInstance().clear();
+    AccessTest::TearDown();
+  }
+};
+
+TEST_F(CostModelTests, learns_parameters_of_host) {
+  CostModel model;
+  model.setPrior(prior);
+  for (size_t i = 0; i < 200; ++i) {
+    const double size = 1 + (i % 20);
+    const size_t instances = 1 + (i % 7);
+    if (i + 1 < CostModel::minimumObservations) {
+      EXPECT_EQ(prior, model.parameters()) << "Too few observations";
+    }
+    model.observe(CostModel::features(size, size, instances), mts(size, instances));
+  }
+  const auto learned = model.parameters();
+  for (size_t i = 0; i < CostModel::parameterCount; ++i)
+    EXPECT_NEAR(actual[i], learned[i], 0.05) << "parameter " << i;
+}
+
+TEST_F(CostModelTests, models_persist_on_same_host) {
+  auto& models = CostModels::getInstance();
+  models.parameters("TableScan", prior);
+  for (size_t i = 0; i < CostModel::minimumObservations; ++i)
+    models.observe("TableScan", CostModel::features(i, i, 1 + i % 3), mts(i, 1 + i % 3));
+  const auto learned = models.parameters("TableScan", prior);
+  const std::string path = "cost_models_test.json";
+  ASSERT_TRUE(models.save(path));
+
+  models.clear();
+  ASSERT_TRUE(models.load(path));
+  EXPECT_EQ(CostModel::minimumObservations, models.observations("TableScan"));
+  const auto loaded = models.parameters("TableScan", prior);
+  for (size_t i = 0; i < CostModel::parameterCount; ++i)
+    EXPECT_NEAR(learned[i], loaded[i], 1e-6) << "parameter " << i;
+  EXPECT_TRUE(models.toJson()["operations"]["TableScan"].isMember("parameters"));
+
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << "{\"host\": \"" << models.host() << "-other\", \"operations\": {}}";
+  }
+  EXPECT_FALSE(models.load(path)) << "Models of other hosts do not apply";
+  EXPECT_EQ(CostModel::minimumObservations, models.observations("TableScan"));
+  std::remove(path.c_str());
+}
+
+TEST_F(CostModelTests, parallelized_instances_are_measured) {
+  auto tbl = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto input = std::make_shared<Barrier>();
+  input->addInput(tbl);
+  input->addField(0);
+  (*input)();
+
+  auto ts = std::make_shared<TableScan>(make_unique<EqualsExpression<hyrise_string_t>>(0, 1, "Apple Inc"));
+  ts->addDependency(input);
+  ts->determineDynamicCount(20);
+  auto instances = ts->applyDynamicParallelization(2);
+  ts->notifyParallelized(instances, 2);
+  // two scans and their union
+  ASSERT_EQ(3u, instances.size());
+
+  (*instances[0])();
+  EXPECT_EQ(0u, CostModels::getInstance().observations("TableScan")) << "Waits for all instances";
+  (*instances[1])();
+  EXPECT_EQ(1u, CostModels::getInstance().observations("TableScan")) << "The union is no instance";
+  (*instances[2])();
+  EXPECT_EQ(1u, CostModels::getInstance().observations("TableScan"));
+}
+
+}}
@@ -1,4 +1,5 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/Barrier.h"
 #include "access/GroupByScan.h"
 #include "access/HashBuild.h"
 #include "io/shortcuts.h"
@@ -82,5 +83,39 @@ TEST_F(GroupByScanTests, group_by_with_aggregate_function) {
   EXPECT_RELATION_EQ(reference, result);
 }
 
+TEST_F(GroupByScanTests, group_by_with_morsel_driven_instances) {
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+  auto reference = io::Loader::shortcuts::load("test/10_30_group_count_result.tbl");
+
+  auto input = std::make_shared<Barrier>();
+  input->addInput(t);
+  input->addField(0);
+  (*input)();
+
+  auto hb = std::make_shared<HashBuild>();
+  hb->addDependency(input);
+  hb->addField(1);
+  hb->setKey("groupby");
+  (*hb)();
+
+  auto gs = std::make_shared<GroupByScan>();
+  gs->addDependency(input);
+  gs->addDependency(hb);
+  gs->addFunction(new CountAggregateFun(0));
+  gs->addField(1);
+
+  auto instances = gs->applyDynamicParallelization(3);
+  // three instances and their union
+  ASSERT_EQ(4u, instances.size());
+
+  // instances starting late find the groups taken
+  for (size_t i = 3; i-- > 0;)
+    (*instances[i])();
+  (*instances[3])();
+
+  const auto &result = std::dynamic_pointer_cast<PlanOperation>(instances[3])->getResultTable();
+  EXPECT_RELATION_EQ(reference, result);
+}
+
 }
 }
@@ -0,0 +1,59 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <map>
+
+#include "access/system/RequestParseTask.h"
+
+namespace hyrise {
+namespace access {
+
+class HeaderConnection : public net::AbstractConnection {
+ public:
+  std::map<std::string, std::string> headers;
+
+  virtual std::string getBody() const { return ""; }
+  virtual std::string getPath() const { return "/query/"; }
+  virtual bool hasBody() const { return false; }
+  virtual std::string getHeader(const std::string &name) const {
+    auto it = headers.find(name);
+    return it == headers.end() ? "" : it->second;
+  }
+  virtual void respond(const std::string &message, size_t status, const std::string& contentType) {}
+};
+
+class JsonRequestTests : public AccessTest {
+ protected:
+  Json::Value parse(const std::string &json) {
+    Json::Value result;
+    Json::Reader reader;
+    reader.parse(json, result);
+    return result;
+  }
+};
+
+TEST_F(JsonRequestTests, options_from_fields) {
+  HeaderConnection connection;
+  auto options = jsonRequestOptions(parse("{\"query\": {\"operators\": {}}, \"autocommit\": true,"
+                                          " \"limit\": 10, \"session_context\": \"5 3\"}"), connection);
+  ASSERT_EQ(3u, options.size());
+  EXPECT_EQ("true", options["autocommit"]);
+  EXPECT_EQ("10", options["limit"]);
+  EXPECT_EQ("5 3", options["session_context"]);
+}
+
+TEST_F(JsonRequestTests, options_from_headers) {
+  HeaderConnection connection;
+  connection.headers["X-Hyrise-Session-Context"] = "5 3";
+  connection.headers["X-Hyrise-Offset"] = "20";
+  connection.headers["X-Hyrise-Limit"] = "10";
+  auto options = jsonRequestOptions(parse("{\"operators\": {}, \"limit\": 5}"), connection);
+  ASSERT_EQ(3u, options.size());
+  EXPECT_EQ("5 3", options["session_context"]);
+  EXPECT_EQ("20", options["offset"]);
+  // Fields take precedence over headers
+  EXPECT_EQ("5", options["limit"]);
+}
+
+}
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "access/system/PlanCache.h"
+#include "access/system/QueryParser.h"
+
+namespace hyrise {
+namespace access {
+
+class PlanCacheTests : public AccessTest {
+ protected:
+  Json::Value parse(const std::string &json) {
+    Json::Value result;
+    Json::Reader reader;
+    reader.parse(json, result);
+    return result;
+  }
+};
+
+TEST_F(PlanCacheTests, bind_parameters) {
+  PreparedPlan plan(parse("{\"operators\": {\"select\": {\"type\": \"SimpleTableScan\", \"predicates\": ["
+                          "{\"type\": \"EQ\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": {\"$param\": \"id\"}},"
+                          "{\"type\": \"EQ\", \"in\": 0, \"f\": 1, \"vtype\": 2, \"value\": {\"$param\": \"name\"}}]}}}"));
+  ASSERT_EQ(2u, plan.parameterCount());
+
+  const auto bound = plan.bind(parse("{\"id\": 42, \"name\": \"Apple Inc\"}"));
+  const auto &predicates = bound["operators"]["select"]["predicates"];
+  ASSERT_EQ(42, predicates[0u]["value"].asInt());
+  ASSERT_EQ("Apple Inc", predicates[1u]["value"].asString());
+
+  ASSERT_THROW(plan.bind(parse("{\"id\": 42}")), QueryParserException);
+}
+
+TEST_F(PlanCacheTests, register_and_replace) {
+  auto &cache = PlanCache::getInstance();
+  cache.add("plan_cache_test", parse("{\"operators\": {}}"));
+  ASSERT_EQ(0u, cache.get("plan_cache_test")->parameterCount());
+
+  cache.add("plan_cache_test", parse("{\"limit\": {\"$param\": \"limit\"}}"));
+  ASSERT_EQ(1u, cache.get("plan_cache_test")->parameterCount());
+
+  ASSERT_TRUE(cache.remove("plan_cache_test"));
+  ASSERT_EQ(nullptr, cache.get("plan_cache_test"));
+}
+
+}
+}
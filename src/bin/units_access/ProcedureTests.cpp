@@ -0,0 +1,106 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "access/procedures/Procedure.h"
+#include "io/shortcuts.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace access {
+
+// Inserts (a, b) and deletes the row at position `remove` if given
+class InsertDeleteProcedure : public Procedure {
+ public:
+  InsertDeleteProcedure() : Procedure(nullptr) {}
+  static std::string name() { return "InsertDeleteProcedure"; }
+  const std::string vname() { return "InsertDeleteProcedure"; }
+
+ protected:
+  Json::Value execute(ProcedureContext &context, const ProcedureParameters &parameters) {
+    auto store = context.getStore("procedure_table");
+    std::vector<Json::Value> row {Json::Value(parameters.get<hyrise_int_t>("a")),
+                                  Json::Value(parameters.get<hyrise_int_t>("b", 0))};
+    const pos_t pos = context.insert(store, row);
+    if (parameters.has("remove")) {
+      context.remove(store, parameters.get<hyrise_int_t>("remove"));
+    }
+    if (parameters.get<bool>("fail", false)) {
+      throw ProcedureException("failed on purpose");
+    }
+    return Json::Value::UInt64(pos);
+  }
+};
+
+class ProcedureTests : public AccessTest {
+ protected:
+  storage::store_ptr_t store;
+
+  virtual void SetUp() {
+    AccessTest::SetUp();
+    store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/insert_one.tbl"));
+    io::StorageManager::getInstance()->loadTable("procedure_table", store);
+  }
+
+  virtual void TearDown() {
+    io::StorageManager::getInstance()->removeTable("procedure_table");
+    AccessTest::TearDown();
+  }
+
+  size_t visibleRows() {
+    auto ctx = tx::TransactionManager::getInstance().buildContext();
+    return store->buildValidPositions(ctx.lastCid, ctx.tid).size();
+  }
+};
+
+TEST_F(ProcedureTests, decode_parameters) {
+  Json::Value values;
+  values["int"] = "42";
+  values["float"] = 1.5;
+  values["flag"] = "true";
+  values["text"] = "abc";
+  ProcedureParameters parameters(values);
+
+  EXPECT_EQ(42, parameters.get<hyrise_int_t>("int"));
+  EXPECT_FLOAT_EQ(1.5, parameters.get<hyrise_float_t>("float"));
+  EXPECT_TRUE(parameters.get<bool>("flag"));
+  EXPECT_EQ("abc", parameters.get<std::string>("text"));
+  EXPECT_EQ(7, parameters.get<hyrise_int_t>("missing", 7));
+  EXPECT_THROW(parameters.get<hyrise_int_t>("missing"), ProcedureException);
+  EXPECT_THROW(parameters.get<hyrise_int_t>("text"), ProcedureException);
+}
+
+TEST_F(ProcedureTests, commits_writes) {
+  Json::Value values;
+  values["a"] = 2;
+  values["remove"] = 0;
+  InsertDeleteProcedure procedure;
+  auto response = procedure.call(ProcedureParameters(values));
+
+  ASSERT_FALSE(response.isMember("error"));
+  EXPECT_EQ(1u, response["result"].asUInt());
+  EXPECT_EQ(2u, response["affectedRows"].asUInt());
+  EXPECT_EQ(1u, visibleRows());
+}
+
+TEST_F(ProcedureTests, rolls_back_on_error) {
+  Json::Value values;
+  values["a"] = 2;
+  values["remove"] = 0;
+  values["fail"] = true;
+  InsertDeleteProcedure procedure;
+  auto response = procedure.call(ProcedureParameters(values));
+
+  ASSERT_TRUE(response.isMember("error"));
+  EXPECT_FALSE(response.isMember("result"));
+  EXPECT_EQ(1u, visibleRows());
+
+  // The deleted row is not marked anymore and can be deleted again
+  values.removeMember("fail");
+  EXPECT_FALSE(procedure.call(ProcedureParameters(values)).isMember("error"));
+  EXPECT_EQ(1u, visibleRows());
+}
+
+}
+}
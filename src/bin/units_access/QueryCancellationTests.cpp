@@ -0,0 +1,40 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "access/system/QueryCancellation.h"
+
+namespace hyrise {
+namespace access {
+
+class QueryCancellationTests : public AccessTest {};
+
+TEST_F(QueryCancellationTests, cancel_by_query_id) {
+  auto token = std::make_shared<CancellationToken>();
+  auto other = std::make_shared<CancellationToken>();
+  auto &queries = RunningQueries::getInstance();
+  queries.add("cancellation_test", token);
+  queries.add("cancellation_test_other", other);
+
+  ASSERT_FALSE(token->isCancelled());
+  ASSERT_EQ(1u, queries.cancel("cancellation_test", "test"));
+  ASSERT_TRUE(token->isCancelled());
+  ASSERT_EQ("test", token->reason());
+  ASSERT_THROW(token->check(), QueryCancelledException);
+  ASSERT_FALSE(other->isCancelled());
+
+  queries.remove("cancellation_test", token);
+  queries.remove("cancellation_test_other", other);
+  ASSERT_EQ(0u, queries.cancel("cancellation_test"));
+}
+
+TEST_F(QueryCancellationTests, deadline) {
+  CancellationToken expired(CancellationToken::clock_t::now());
+  ASSERT_TRUE(expired.isCancelled());
+  ASSERT_EQ("deadline exceeded", expired.reason());
+
+  CancellationToken running(CancellationToken::clock_t::now() + std::chrono::hours(1));
+  ASSERT_NO_THROW(running.check());
+}
+
+}
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "access/system/ResultCursors.h"
+#include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/AbstractTable.h"
+
+namespace hyrise {
+namespace access {
+
+class ResultCursorsTests : public AccessTest {};
+
+TEST_F(ResultCursorsTests, open_fetch_close) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto &cursors = ResultCursors::getInstance();
+  const auto ctx = tx::TransactionManager::beginTransaction();
+
+  const std::string id = cursors.open(t, ctx);
+  const std::string other = cursors.open(t, ctx);
+  ASSERT_NE(id, other);
+
+  const auto result = cursors.fetch(id);
+  ASSERT_NE(nullptr, result);
+  ASSERT_EQ(t->size(), result->size());
+
+  ASSERT_TRUE(cursors.close(id));
+  ASSERT_EQ(nullptr, cursors.fetch(id));
+  ASSERT_TRUE(cursors.close(other));
+}
+
+TEST_F(ResultCursorsTests, expire) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto &cursors = ResultCursors::getInstance();
+  const std::string id = cursors.open(t, tx::TransactionManager::beginTransaction(), 0);
+  ASSERT_EQ(nullptr, cursors.fetch(id));
+}
+
+TEST_F(ResultCursorsTests, pin_snapshot_until_closed) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto &cursors = ResultCursors::getInstance();
+  auto &txmgr = tx::TransactionManager::getInstance();
+  const auto ctx = tx::TransactionManager::beginTransaction();
+  const std::string id = cursors.open(t, ctx);
+  tx::TransactionManager::commitTransaction(tx::TransactionManager::beginTransaction());
+  EXPECT_EQ(ctx.lastCid, txmgr.getOldestActiveSnapshot());
+
+  ASSERT_TRUE(cursors.close(id));
+  EXPECT_EQ(txmgr.getLastCommitId(), txmgr.getOldestActiveSnapshot());
+}
+
+TEST_F(ResultCursorsTests, expired_cursors_release_their_snapshot) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto &cursors = ResultCursors::getInstance();
+  auto &txmgr = tx::TransactionManager::getInstance();
+  cursors.open(t, tx::TransactionManager::beginTransaction(), 0);
+  tx::TransactionManager::commitTransaction(tx::TransactionManager::beginTransaction());
+
+  cursors.expire();
+  EXPECT_EQ(0u, cursors.size());
+  EXPECT_EQ(txmgr.getLastCommitId(), txmgr.getOldestActiveSnapshot());
+}
+
+TEST_F(ResultCursorsTests, limit_open_cursors) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto &cursors = ResultCursors::getInstance();
+  const auto ctx = tx::TransactionManager::beginTransaction();
+  cursors.setMaxCursors(2);
+  const std::string first = cursors.open(t, ctx);
+  cursors.open(t, ctx);
+  EXPECT_THROW(cursors.open(t, ctx), std::runtime_error);
+
+  ASSERT_TRUE(cursors.close(first));
+  EXPECT_NO_THROW(cursors.open(t, ctx));
+  cursors.clear();
+  cursors.setMaxCursors(ResultCursors::defaultMaxCursors);
+}
+
+}
+}
@@ -57,5 +57,31 @@ TEST_F(SimpleTableScanTests, parallelized_simple_table_scan) {
   ASSERT_EQ(100, result->getValue<storage::hyrise_int_t>(0, 0));
 }
 
+// NOT(col_0 < 40000 OR col_1 > 150001) spans several batches of rows
+TEST_F(SimpleTableScanTests, batched_compound_predicates) {
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/test10k_12.tbl");
+  auto expr = new CompoundExpression(
+      new CompoundExpression(new LessThanExpression<storage::hyrise_int_t>(t, 0, 40000),
+                             new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 150001),
+                             OR),
+      nullptr,
+      NOT);
+
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(expr);
+  sts.setProducesPositions(true);
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+
+  ASSERT_EQ(5501u, result->size());
+  ASSERT_EQ(40000, result->getValue<storage::hyrise_int_t>(0, 0));
+  ASSERT_EQ(150000, result->getValue<storage::hyrise_int_t>(0, result->size() - 1));
+  for (size_t row = 0; row < t->size(); ++row) {
+    ASSERT_EQ(row >= 2000 && row <= 7500, (*expr)(row));
+  }
+}
+
 }
 }
@@ -3,9 +3,15 @@
 #include "access/TableScan.h"
 #include "access/expressions/pred_EqualsExpression.h"
 #include "access/expressions/pred_CompoundExpression.h"
+#include "access/expressions/pred_GreaterThanExpression.h"
 #include "io/shortcuts.h"
 #include "access/Barrier.h"
+#include "access/system/MorselCursor.h"
 #include "helper/make_unique.h"
+#include "storage/PointerCalculator.h"
+
+#include <algorithm>
+#include <thread>
 
 namespace hyrise { namespace access {
 
@@ -26,6 +32,80 @@ TEST(TableScan, test2) {
   ASSERT_EQ(1u, result->size());
 }
 
+TEST(TableScan, predicates) {
+  Json::Value data;
+  Json::Reader reader;
+  reader.parse("{\"predicates\": [{\"type\": \"OR\"},"
+               " {\"type\": \"EQ\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 1},"
+               " {\"type\": \"EQ\", \"in\": 0, \"f\": 1, \"vtype\": 2, \"value\": \"SAP AG\"}]}",
+               data);
+  auto tbl = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto ts = TableScan::parse(data);
+  ts->addInput(tbl);
+  const auto& result = ts->execute()->getResultTable();
+  ASSERT_EQ(2u, result->size());
+}
+
+TEST(TableScan, morsel_driven_instances) {
+  auto tbl = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto morsels = std::make_shared<MorselCursor>(tbl->size(), 2);
+
+  TableScan ts1(make_unique<EqualsExpression<hyrise_string_t>>(0, 1, "Apple Inc"));
+  ts1.addInput(tbl);
+  ts1.setMorsels(morsels);
+  TableScan ts2(make_unique<EqualsExpression<hyrise_string_t>>(0, 1, "Apple Inc"));
+  ts2.addInput(tbl);
+  ts2.setMorsels(morsels);
+
+  // the first instance pulls all morsels, the second finds the input exhausted
+  ASSERT_EQ(1u, ts1.execute()->getResultTable()->size());
+  ASSERT_EQ(0u, ts2.execute()->getResultTable()->size());
+  size_t first, last;
+  EXPECT_FALSE(morsels->next(first, last));
+}
+
+TEST(TableScan, morsel_driven_instances_keep_row_order) {
+  auto tbl = io::Loader::shortcuts::load("test/test10k_12.tbl");
+  auto input = std::make_shared<Barrier>();
+  input->addInput(tbl);
+  input->addField(0);
+  (*input)();
+
+  TableScan sequential(make_unique<GreaterThanExpression<hyrise_int_t>>(0, 0, 5000));
+  sequential.addInput(tbl);
+  const auto& expected = std::dynamic_pointer_cast<const storage::PointerCalculator>(sequential.execute()->getResultTable());
+
+  auto ts = std::make_shared<TableScan>(make_unique<GreaterThanExpression<hyrise_int_t>>(0, 0, 5000));
+  ts->addDependency(input);
+  auto instances = ts->applyDynamicParallelization(2);
+  ASSERT_EQ(3u, instances.size());
+
+  // the instances pull morsels concurrently, so their morsels interleave
+  std::thread other([&instances] { (*instances[1])(); });
+  (*instances[0])();
+  other.join();
+  (*instances[2])();
+
+  const auto& result = std::dynamic_pointer_cast<const storage::PointerCalculator>(
+      std::dynamic_pointer_cast<PlanOperation>(instances[2])->getResultTable());
+  ASSERT_TRUE(result != nullptr);
+  const auto* positions = result->getPositions();
+  EXPECT_TRUE(std::is_sorted(positions->begin(), positions->end()));
+  EXPECT_EQ(*expected->getPositions(), *positions);
+}
+
+TEST(TableScan, morsels_cover_input_once) {
+  MorselCursor morsels(10, 4);
+  std::vector<std::pair<size_t, size_t>> handedOut;
+  size_t first, last;
+  while (morsels.next(first, last))
+    handedOut.emplace_back(first, last);
+  std::vector<std::pair<size_t, size_t>> expected {{0, 4}, {4, 8}, {8, 10}};
+  EXPECT_EQ(expected, handedOut);
+  EXPECT_EQ(MorselCursor::minimumMorselSize, MorselCursor::morselSizeFor(100, 4));
+  EXPECT_EQ(MorselCursor::defaultMorselSize, MorselCursor::morselSizeFor(100000000, 4));
+}
+
 TEST(TableScan, testDynamicParallelization) {
   auto MTS = 20;
 
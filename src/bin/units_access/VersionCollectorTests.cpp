@@ -0,0 +1,95 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/BulkInsert.h"
+#include "io/shortcuts.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "io/VersionCollector.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+using TM = tx::TransactionManager;
+
+class VersionCollectorTests : public AccessTest {
+ public:
+  storage::store_ptr_t store;
+
+  void SetUp() {
+    AccessTest::SetUp();
+    store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/insert_one.tbl"));
+  }
+
+  void insert(const tx::TXContext& ctx, const std::string& csv) {
+    BulkInsert bi;
+    bi.setTXContext(ctx);
+    bi.addInput(store);
+    bi.setCSV(csv);
+    bi.execute();
+  }
+
+  void remove(pos_t pos) {
+    auto ctx = TM::beginTransaction();
+    ASSERT_EQ(tx::TX_CODE::TX_OK, store->markForDeletion(pos, ctx.tid));
+    TM::getInstance()[ctx.tid].deletePos(store, pos);
+    TM::commitTransaction(ctx);
+  }
+};
+
+TEST_F(VersionCollectorTests, compact_removes_versions_no_snapshot_sees) {
+  const size_t main = store->getMainTable()->size();
+  auto writer = TM::beginTransaction();
+  insert(writer, "2|3\n4|5\n6|7\n");
+  TM::commitTransaction(writer);
+
+  auto reader = TM::beginReadOnlyTransaction();
+  remove(main + 1);
+  auto aborted = TM::beginTransaction();
+  insert(aborted, "8|9\n");
+  TM::rollbackTransaction(aborted);
+
+  // The reader still sees the deleted row, the rolled back row is gone
+  EXPECT_EQ(1u, store->compactDelta(reader.lastCid));
+  EXPECT_EQ(3u, store->getDeltaTable()->size());
+  EXPECT_EQ(main + 3, store->buildValidPositions(reader.lastCid, reader.tid).size());
+  TM::commitTransaction(reader);
+
+  const auto lastCid = TM::getInstance().getLastCommitId();
+  EXPECT_EQ(1u, store->compactDelta(lastCid));
+  ASSERT_EQ(2u, store->getDeltaTable()->size());
+  EXPECT_EQ(2, store->getDeltaTable()->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(7, store->getDeltaTable()->getValue<hyrise_int_t>(1, 1));
+  EXPECT_EQ(main + 2, store->buildValidPositions(lastCid, tx::READ_ONLY_TID).size());
+}
+
+TEST_F(VersionCollectorTests, running_transactions_keep_their_rows) {
+  auto ctx = TM::beginTransaction();
+  insert(ctx, "2|3\n");
+  EXPECT_EQ(0u, store->compactDelta(TM::getInstance().getLastCommitId()));
+
+  TM::rollbackTransaction(ctx);
+  EXPECT_EQ(0u, store->compactDelta(TM::getInstance().getLastCommitId(), 2)) << "Below the minimum";
+  EXPECT_EQ(1u, store->compactDelta(TM::getInstance().getLastCommitId()));
+}
+
+TEST_F(VersionCollectorTests, collector_skips_referenced_stores) {
+  auto sm = io::StorageManager::getInstance();
+  sm->loadTable("versions", store);
+  const size_t main = store->getMainTable()->size();
+  auto aborted = TM::beginTransaction();
+  insert(aborted, "2|3\n");
+  TM::rollbackTransaction(aborted);
+
+  auto& collector = io::VersionCollector::getInstance();
+  collector.setMinimumRows(1);
+  EXPECT_EQ(0u, collector.collect()) << "The test still references the store";
+
+  store.reset();
+  EXPECT_EQ(1u, collector.collect());
+  EXPECT_EQ(main, sm->getTable("versions")->size());
+  collector.setMinimumRows(io::VersionCollector::defaultMinimumRows);
+}
+
+}
+}
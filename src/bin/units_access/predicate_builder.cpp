@@ -71,6 +71,40 @@ TEST_F(PredicateBldr, complex_expression) {
   ASSERT_TRUE(out->contentEquals(reference));
 }
 
+TEST_F(PredicateBldr, fused_conjunction) {
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/test10k_12.tbl");
+
+  Json::Value predicates;
+  Json::Reader reader;
+  // col_0 >= 40000 AND col_1 < 150001
+  reader.parse("[{\"type\": \"AND\"},"
+               " {\"type\": \"GTE_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 40000},"
+               " {\"type\": \"LT\", \"in\": 0, \"f\": \"col_1\", \"vtype\": 0, \"value\": 150001}]",
+               predicates);
+  SimpleExpression *expr = buildExpression(predicates);
+  ASSERT_NE(nullptr, dynamic_cast<FusedConjunction<2>*>(expr));
+
+  auto scan = std::make_shared<SimpleTableScan>();
+  scan->addInput(t);
+  scan->setPredicate(expr);
+  scan->setProducesPositions(true);
+
+  auto out = scan->execute()->getResultTable();
+  ASSERT_EQ(5500u, out->size());
+  ASSERT_EQ(40000, out->getValue<hyrise_int_t>(0, 0));
 }
+
+TEST_F(PredicateBldr, no_fused_disjunction) {
+  Json::Value predicates;
+  Json::Reader reader;
+  reader.parse("[{\"type\": \"OR\"},"
+               " {\"type\": \"EQ\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 1},"
+               " {\"type\": \"EQ\", \"in\": 0, \"f\": 1, \"vtype\": 0, \"value\": 2}]",
+               predicates);
+  SimpleExpression *expr = buildExpression(predicates);
+  ASSERT_NE(nullptr, dynamic_cast<CompoundExpression*>(expr));
+  delete expr;
 }
 
+}
+}
@@ -6,6 +6,8 @@
 
 #include <access.h>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 #include <io/shortcuts.h>
 #include <storage/Store.h>
@@ -550,4 +552,52 @@ TEST_F(TransactionTests, delete_rollback) {
   ASSERT_EQ(tx::START_TID, linxxxs->tid(0));
 }
 
+TEST_F(TransactionTests, snapshots_are_pinned_once_transactions_read) {
+  auto& txmgr = tx::TransactionManager::getInstance();
+  auto writer = tx::TransactionManager::beginTransaction();
+  auto reader = tx::TransactionManager::beginTransaction();
+  txmgr.pinSnapshot(reader);
+  tx::TransactionManager::commitTransaction(writer);
+  EXPECT_EQ(reader.lastCid, txmgr.getOldestActiveSnapshot());
+
+  tx::TransactionManager::commitTransaction(reader);
+  EXPECT_EQ(txmgr.getLastCommitId(), txmgr.getOldestActiveSnapshot());
+}
+
+TEST_F(TransactionTests, collected_snapshots_cannot_be_pinned) {
+  auto& txmgr = tx::TransactionManager::getInstance();
+  auto idle = tx::TransactionManager::beginTransaction();
+  tx::TransactionManager::commitTransaction(tx::TransactionManager::beginTransaction());
+  // The collector passes the snapshot nobody pinned
+  ASSERT_LT(idle.lastCid, txmgr.getOldestActiveSnapshot());
+  EXPECT_THROW(txmgr.pinSnapshot(idle), std::runtime_error);
+  tx::TransactionManager::rollbackTransaction(idle);
+}
+
+TEST_F(TransactionTests, idle_snapshots_expire) {
+  auto& txmgr = tx::TransactionManager::getInstance();
+  txmgr.setSnapshotTimeout(std::chrono::milliseconds(5));
+  auto idle = tx::TransactionManager::beginTransaction(true);
+  tx::TransactionManager::commitTransaction(tx::TransactionManager::beginTransaction());
+  EXPECT_EQ(idle.lastCid, txmgr.getOldestActiveSnapshot());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(txmgr.getLastCommitId(), txmgr.getOldestActiveSnapshot());
+  EXPECT_THROW(txmgr.pinSnapshot(idle), std::runtime_error);
+  tx::TransactionManager::rollbackTransaction(idle);
+  txmgr.setSnapshotTimeout(std::chrono::steady_clock::duration::zero());
+}
+
+TEST_F(TransactionTests, failed_requests_roll_back_their_transaction) {
+  auto& txmgr = tx::TransactionManager::getInstance();
+  // Not autocommitted and reading, the transaction pins its snapshot
+  const std::string failing = "{\"operators\": {"
+      "\"load\": {\"type\": \"GetTable\", \"name\": \"no_such_table\"},"
+      "\"validate\": {\"type\": \"ValidatePositions\"}},"
+      "\"edges\": [[\"load\", \"validate\"]]}";
+  EXPECT_THROW(executeAndWait(failing), std::runtime_error);
+  tx::TransactionManager::commitTransaction(tx::TransactionManager::beginTransaction());
+  EXPECT_EQ(txmgr.getLastCommitId(), txmgr.getOldestActiveSnapshot());
+}
+
 }}
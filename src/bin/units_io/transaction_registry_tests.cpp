@@ -0,0 +1,74 @@
+#include "testing/test.h"
+
+#include <thread>
+#include <vector>
+
+#include "helper/EpochReclamation.h"
+#include "io/TransactionManager.h"
+#include "io/TransactionRegistry.h"
+
+namespace hyrise {
+namespace tx {
+
+// Transactions with ids in the same shard as 5
+const transaction_id_t sibling = 5 + TransactionRegistry::shardCount;
+
+TEST(TransactionRegistryTests, register_find_erase) {
+  TransactionRegistry registry;
+  EXPECT_TRUE(registry.find(5) == nullptr);
+
+  auto& data = registry.getOrCreate(5);
+  EXPECT_EQ(5, data._modifications.tid);
+  EXPECT_EQ(&data, registry.find(5));
+  EXPECT_EQ(&data, &registry.getOrCreate(5));
+
+  registry.erase(5);
+  EXPECT_TRUE(registry.find(5) == nullptr);
+}
+
+TEST(TransactionRegistryTests, reuses_erased_entries) {
+  TransactionRegistry registry;
+  auto* first = &registry.getOrCreate(5);
+  registry.erase(5);
+
+  // Same shard, no reader pins the erased entry
+  auto* second = &registry.getOrCreate(sibling);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(sibling, second->_context.tid);
+}
+
+TEST(TransactionRegistryTests, pinned_readers_delay_reuse) {
+  TransactionRegistry registry;
+  auto* first = &registry.getOrCreate(5);
+  {
+    locking::EpochReclamation::Guard guard;
+    registry.erase(5);
+    EXPECT_NE(first, &registry.getOrCreate(sibling));
+  }
+  EXPECT_EQ(first, &registry.getOrCreate(sibling + TransactionRegistry::shardCount));
+}
+
+TEST(TransactionRegistryTests, concurrent_transactions) {
+  TransactionRegistry registry;
+  const size_t threads = 8, transactions = 1000;
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&registry, t, threads, transactions] () {
+        for (size_t i = 0; i < transactions; ++i) {
+          const transaction_id_t tid = START_TID + static_cast<transaction_id_t>(i * threads + t);
+          auto& data = registry.getOrCreate(tid);
+          EXPECT_EQ(&data, registry.find(tid));
+          registry.erase(tid);
+        }
+      });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  size_t registered = 0;
+  registry.forEach([&registered] (const TransactionData&) { ++registered; });
+  EXPECT_EQ(0u, registered);
+}
+
+} } // namespace hyrise::tx
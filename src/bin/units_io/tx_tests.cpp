@@ -1,6 +1,9 @@
 #include "testing/test.h"
 
+#include <algorithm>
 #include <limits>
+#include <thread>
+#include <vector>
 
 #include "io/TransactionManager.h"
 
@@ -45,4 +48,49 @@ TEST(TX, rollback_transaction) {
   EXPECT_EQ(before, after) << "No commits are made when doing a rollback";
 }
 
+TEST(TX, read_only_snapshot) {
+  auto before = TM::getInstance().getLastCommitId();
+  auto snapshot = TM::beginReadOnlyTransaction();
+  EXPECT_TRUE(snapshot.isReadOnly());
+  EXPECT_EQ(before, snapshot.lastCid);
+  EXPECT_THROW(TM::getInstance()[snapshot.tid], std::runtime_error);
+
+  EXPECT_EQ(before, TM::commitTransaction(snapshot));
+  EXPECT_EQ(before, TM::getInstance().getLastCommitId()) << "Snapshots do not consume commit ids";
+  EXPECT_EQ(TM::getCurrentModifyingTransactionContexts().size(), 0u);
+}
+
+TEST(TX, concurrent_commits_get_consecutive_ids) {
+  const size_t threads = 16, commits = 100;
+  auto before = TM::getInstance().getLastCommitId();
+
+  std::vector<std::vector<transaction_cid_t>> cids(threads);
+  std::vector<std::thread> committers;
+  for (size_t t = 0; t < threads; ++t) {
+    committers.emplace_back([&cids, t, commits] () {
+        for (size_t i = 0; i < commits; ++i) {
+          auto tx = TM::beginTransaction();
+          auto cid = TM::commitTransaction(tx);
+          // A returned commit id is visible
+          EXPECT_GE(TM::getInstance().getLastCommitId(), cid);
+          cids[t].push_back(cid);
+        }
+      });
+  }
+  for (auto& committer : committers) {
+    committer.join();
+  }
+
+  std::vector<transaction_cid_t> all;
+  for (const auto& c : cids) {
+    all.insert(all.end(), c.begin(), c.end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(threads * commits, all.size());
+  for (size_t i = 0; i < all.size(); ++i) {
+    EXPECT_EQ(before + i + 1, all[i]);
+  }
+  EXPECT_EQ(before + threads * commits, TM::getInstance().getLastCommitId());
+}
+
 } } // namespace hyrise::tx
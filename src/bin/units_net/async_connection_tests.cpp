@@ -0,0 +1,110 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "net/AsyncConnection.h"
+
+namespace hyrise {
+namespace net {
+
+// A response that is not attached to a running event loop, its chunks
+// stay queued as no loop writes them
+class AsyncConnectionTests : public ::testing::Test {
+ protected:
+  struct ev_loop *loop;
+  ebb_connection *connection;
+  ClientConnection *client;
+  AsyncConnection *conn;
+
+  virtual void SetUp() {
+    loop = ev_loop_new(EVFLAG_AUTO);
+    connection = (ebb_connection *)malloc(sizeof(ebb_connection));
+    ebb_connection_init(connection);
+    client = new ClientConnection;
+    client->connection = connection;
+    client->ev_loop = loop;
+    connection->data = client;
+
+    conn = new AsyncConnection;
+    conn->connection = connection;
+    conn->client = client;
+    conn->ev_loop = loop;
+    conn->keep_alive_flag = true;
+    ev_async_init(&conn->ev_write, write_cb);
+    conn->ev_write.data = conn;
+    client->requests.push_back(conn);
+  }
+
+  virtual void TearDown() {
+    // on_close frees the client connection
+    if (client != nullptr) {
+      on_close(connection);
+    }
+    delete conn;
+    ev_loop_destroy(loop);
+  }
+
+  void closeClient() {
+    on_close(connection);
+    client = nullptr;
+  }
+};
+
+TEST_F(AsyncConnectionTests, chunks_are_framed) {
+  conn->beginChunkedResponse(200, "text/plain");
+  conn->writeChunk("abc");
+  conn->writeChunk("");
+  conn->writeChunk(std::string(26, 'x'));
+  conn->endChunkedResponse();
+
+  ASSERT_EQ(4u, conn->chunks.size());
+  EXPECT_EQ("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nTransfer-Encoding: chunked\r\n"
+            "Connection: Keep-Alive\r\n\r\n", conn->chunks[0]);
+  EXPECT_EQ("3\r\nabc\r\n", conn->chunks[1]);
+  EXPECT_EQ("1a\r\n" + std::string(26, 'x') + "\r\n", conn->chunks[2]);
+  EXPECT_EQ("0\r\n\r\n", conn->chunks[3]);
+  EXPECT_TRUE(conn->chunks_done);
+}
+
+TEST_F(AsyncConnectionTests, full_queue_throttles_writer) {
+  conn->beginChunkedResponse();
+  bool resumed = false;
+  conn->whenWritable([&resumed] () { resumed = true; });
+  EXPECT_TRUE(resumed) << "writable connections resume right away";
+
+  conn->writeChunk(std::string(AsyncConnection::max_queued_bytes, 'x'));
+  EXPECT_FALSE(conn->isWritable());
+  resumed = false;
+  conn->whenWritable([&resumed] () { resumed = true; });
+  EXPECT_FALSE(resumed) << "the event loop resumes once the chunks drained";
+  EXPECT_TRUE((bool) conn->on_writable);
+}
+
+TEST_F(AsyncConnectionTests, close_resumes_throttled_writer) {
+  conn->beginChunkedResponse();
+  conn->writeChunk(std::string(AsyncConnection::max_queued_bytes, 'x'));
+  bool resumed = false;
+  conn->whenWritable([&resumed] () { resumed = true; });
+  closeClient();
+
+  EXPECT_TRUE(resumed);
+  EXPECT_EQ(nullptr, conn->connection);
+  EXPECT_TRUE(conn->isWritable());
+  conn->writeChunk("y");
+  conn->endChunkedResponse();
+  EXPECT_EQ(2u, conn->chunks.size()) << "nothing is queued after the close";
+}
+
+TEST_F(AsyncConnectionTests, stalled_stream_times_out) {
+  EXPECT_EQ(EBB_AGAIN, on_timeout(connection)) << "idle connections are kept";
+  conn->beginChunkedResponse();
+  conn->writeChunk("abc");
+  EXPECT_EQ(EBB_AGAIN, on_timeout(connection));
+
+  // The client did not read the chunk being written for the whole timeout
+  conn->chunk_writing = true;
+  EXPECT_EQ(EBB_STOP, on_timeout(connection));
+}
+
+} } // namespace hyrise::net
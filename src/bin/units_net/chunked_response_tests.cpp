@@ -0,0 +1,43 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include "net/AbstractConnection.h"
+
+namespace hyrise {
+namespace net {
+
+class RecordingConnection : public AbstractConnection {
+ public:
+  std::string body;
+  size_t status = 0;
+  std::string contentType;
+  size_t responses = 0;
+
+  virtual std::string getBody() const { return ""; }
+  virtual std::string getPath() const { return "/"; }
+  virtual bool hasBody() const { return false; }
+  virtual void respond(const std::string &message, size_t status, const std::string& contentType) {
+    body = message;
+    this->status = status;
+    this->contentType = contentType;
+    ++responses;
+  }
+};
+
+TEST(ChunkedResponseTests, default_collects_chunks) {
+  RecordingConnection conn;
+  conn.beginChunkedResponse(200, "text/plain");
+  conn.writeChunk("{\"rows\":[");
+  conn.writeChunk("");
+  conn.writeChunk("[1],[2]");
+  EXPECT_EQ(0u, conn.responses);
+  conn.writeChunk("]}");
+  conn.endChunkedResponse();
+
+  EXPECT_EQ(1u, conn.responses);
+  EXPECT_EQ("{\"rows\":[[1],[2]]}", conn.body);
+  EXPECT_EQ(200u, conn.status);
+  EXPECT_EQ("text/plain", conn.contentType);
+}
+
+} } // namespace hyrise::net
@@ -0,0 +1,293 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "net/AbstractConnection.h"
+#include "net/EventLoopGroup.h"
+#include "net/Router.h"
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace net {
+
+namespace {
+std::atomic<size_t> slowResponses(0);
+std::atomic<size_t> streamSuspensions(0);
+
+const size_t streamChunkSize = 64 * 1024;
+const size_t streamChunks = 256;
+}
+
+// Answers with its path after a while, so later requests finish first
+class SlowHandler : public AbstractRequestHandler {
+  static bool registered;
+  AbstractConnection *_connection_data;
+ public:
+  explicit SlowHandler(AbstractConnection *data) : _connection_data(data) {}
+  static std::string name() { return "SlowHandler"; }
+  const std::string vname() { return "SlowHandler"; }
+  void operator()() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    _connection_data->respond(_connection_data->getPath(), 200, "text/plain");
+    ++slowResponses;
+  }
+};
+
+class FastHandler : public AbstractRequestHandler {
+  static bool registered;
+  AbstractConnection *_connection_data;
+ public:
+  explicit FastHandler(AbstractConnection *data) : _connection_data(data) {}
+  static std::string name() { return "FastHandler"; }
+  const std::string vname() { return "FastHandler"; }
+  void operator()() {
+    _connection_data->respond(_connection_data->getPath(), 200, "text/plain");
+  }
+};
+
+// Streams more than the connection queues, continuing in a new thread
+// whenever the client lags behind
+class StreamHandler : public AbstractRequestHandler {
+  static bool registered;
+  AbstractConnection *_connection_data;
+ public:
+  explicit StreamHandler(AbstractConnection *data) : _connection_data(data) {}
+  static std::string name() { return "StreamHandler"; }
+  const std::string vname() { return "StreamHandler"; }
+  void operator()() {
+    _connection_data->beginChunkedResponse(200, "text/plain");
+    stream(_connection_data, 0);
+  }
+
+  static void stream(AbstractConnection *connection, size_t chunk) {
+    for (; chunk < streamChunks; ++chunk) {
+      if (!connection->isWritable()) {
+        ++streamSuspensions;
+        connection->whenWritable([connection, chunk] () {
+            std::thread(&StreamHandler::stream, connection, chunk).detach();
+          });
+        return;
+      }
+      connection->writeChunk(std::string(streamChunkSize, 'a' + chunk % 26));
+    }
+    connection->endChunkedResponse();
+  }
+};
+
+bool SlowHandler::registered = Router::registerRoute<SlowHandler>("/test/slow");
+bool FastHandler::registered = Router::registerRoute<FastHandler>("/test/fast");
+bool StreamHandler::registered = Router::registerRoute<StreamHandler>("/test/stream");
+
+/// Blocking HTTP client on a plain socket
+class TestClient {
+ public:
+  explicit TestClient(size_t port) {
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+      close();
+    }
+  }
+
+  ~TestClient() { close(); }
+
+  bool connected() const { return _fd != -1; }
+
+  void close() {
+    if (_fd != -1) {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+
+  void send(const std::string &data) {
+    ASSERT_EQ((ssize_t) data.size(), ::send(_fd, data.data(), data.size(), MSG_NOSIGNAL));
+  }
+
+  static std::string request(const std::string &path, bool keep_alive = true) {
+    return "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n" +
+        (keep_alive ? "" : "Connection: close\r\n") + "\r\n";
+  }
+
+  /// Next response as (headers, body), empty once the server closed the connection
+  std::pair<std::string, std::string> response() {
+    size_t header_end;
+    while ((header_end = _buffer.find("\r\n\r\n")) == std::string::npos) {
+      if (!receive()) {
+        return {};
+      }
+    }
+    const std::string headers = _buffer.substr(0, header_end + 2);
+    const auto length_pos = headers.find("Content-Length: ");
+    const size_t length = length_pos == std::string::npos ? 0 : strtoul(headers.c_str() + length_pos + 16, nullptr, 10);
+    const size_t end = header_end + 4 + length;
+    while (_buffer.size() < end) {
+      if (!receive()) {
+        return {};
+      }
+    }
+    std::pair<std::string, std::string> result(headers, _buffer.substr(header_end + 4, length));
+    _buffer.erase(0, end);
+    return result;
+  }
+
+  /// Decoded body of the next chunked response, empty if it is incomplete
+  std::string chunkedResponse() {
+    size_t pos;
+    while ((pos = _buffer.find("\r\n\r\n")) == std::string::npos) {
+      if (!receive()) {
+        return "";
+      }
+    }
+    pos += 4;
+    std::string body;
+    while (true) {
+      size_t line_end;
+      while ((line_end = _buffer.find("\r\n", pos)) == std::string::npos) {
+        if (!receive()) {
+          return "";
+        }
+      }
+      const size_t length = strtoul(_buffer.c_str() + pos, nullptr, 16);
+      const size_t end = line_end + 2 + length + 2;
+      while (_buffer.size() < end) {
+        if (!receive()) {
+          return "";
+        }
+      }
+      body.append(_buffer, line_end + 2, length);
+      pos = end;
+      if (length == 0) {
+        _buffer.erase(0, end);
+        return body;
+      }
+    }
+  }
+
+  /// True once the server closed the connection and all responses were read
+  bool closedByServer() {
+    return _buffer.empty() && !receive();
+  }
+
+ private:
+  bool receive() {
+    char data[4096];
+    const ssize_t received = recv(_fd, data, sizeof(data), 0);
+    if (received <= 0) {
+      return false;
+    }
+    _buffer.append(data, received);
+    return true;
+  }
+
+  int _fd = -1;
+  std::string _buffer;
+};
+
+class ClientConnectionTests : public ::testing::Test {
+ protected:
+  std::unique_ptr<EventLoopGroup> loops;
+  std::thread loopThread;
+  size_t port = 31200;
+
+  virtual void SetUp() {
+    taskscheduler::SharedScheduler::getInstance().resetScheduler("ThreadPerTaskScheduler");
+    loops.reset(new EventLoopGroup(1));
+    while (!loops->listen(port)) {
+      ASSERT_LT(++port, 31300u) << "no free port";
+    }
+    loopThread = std::thread([this] () { loops->run(); });
+  }
+
+  virtual void TearDown() {
+    loops->shutdown();
+    loopThread.join();
+  }
+};
+
+TEST_F(ClientConnectionTests, keep_alive_connections_are_reused) {
+  TestClient client(port);
+  ASSERT_TRUE(client.connected());
+
+  client.send(TestClient::request("/test/fast"));
+  auto response = client.response();
+  EXPECT_NE(std::string::npos, response.first.find("Connection: Keep-Alive"));
+  EXPECT_EQ("/test/fast", response.second);
+
+  client.send(TestClient::request("/test/slow"));
+  EXPECT_EQ("/test/slow", client.response().second);
+
+  // The last request closes the connection once it is answered
+  client.send(TestClient::request("/test/fast", false));
+  response = client.response();
+  EXPECT_NE(std::string::npos, response.first.find("Connection: Close"));
+  EXPECT_EQ("/test/fast", response.second);
+  EXPECT_TRUE(client.closedByServer());
+}
+
+TEST_F(ClientConnectionTests, pipelined_requests_are_answered_in_order) {
+  TestClient client(port);
+  ASSERT_TRUE(client.connected());
+
+  // The second request is answered first, its response waits for the first one
+  client.send(TestClient::request("/test/slow") + TestClient::request("/test/fast") +
+              TestClient::request("/test/slow", false));
+  EXPECT_EQ("/test/slow", client.response().second);
+  EXPECT_EQ("/test/fast", client.response().second);
+  EXPECT_EQ("/test/slow", client.response().second);
+  EXPECT_TRUE(client.closedByServer());
+}
+
+TEST_F(ClientConnectionTests, client_closes_with_pending_requests) {
+  const size_t answered = slowResponses;
+  {
+    TestClient client(port);
+    ASSERT_TRUE(client.connected());
+    client.send(TestClient::request("/test/slow") + TestClient::request("/test/fast") +
+                TestClient::request("/test/slow"));
+  }
+
+  // The responses to the closed connection are dropped
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (slowResponses < answered + 2) {
+    ASSERT_LT(std::chrono::steady_clock::now(), deadline) << "pending requests were not answered";
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  TestClient other(port);
+  ASSERT_TRUE(other.connected());
+  other.send(TestClient::request("/test/fast", false));
+  EXPECT_EQ("/test/fast", other.response().second);
+  EXPECT_TRUE(other.closedByServer());
+}
+
+TEST_F(ClientConnectionTests, streams_wait_for_slow_clients) {
+  const size_t suspensions = streamSuspensions;
+  TestClient client(port);
+  ASSERT_TRUE(client.connected());
+  client.send(TestClient::request("/test/stream", false));
+
+  // The client reads late, the stream is throttled instead of queueing it all
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const std::string body = client.chunkedResponse();
+  ASSERT_EQ(streamChunks * streamChunkSize, body.size());
+  for (size_t chunk = 0; chunk < streamChunks; ++chunk) {
+    ASSERT_EQ(std::string(streamChunkSize, 'a' + chunk % 26), body.substr(chunk * streamChunkSize, streamChunkSize));
+  }
+  EXPECT_LT(suspensions, streamSuspensions.load());
+  EXPECT_TRUE(client.closedByServer());
+}
+
+} } // namespace hyrise::net
@@ -0,0 +1,26 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include "net/EventLoopGroup.h"
+
+namespace hyrise {
+namespace net {
+
+TEST(EventLoopGroupTests, loops_share_port_and_shut_down) {
+  EventLoopGroup loops(2);
+  ASSERT_EQ(2u, loops.size());
+
+  size_t port = 31000;
+  while (!loops.listen(port)) {
+    ASSERT_LT(++port, 31100u) << "no free port";
+  }
+
+  // The port is taken for other servers, even with more than one loop
+  EventLoopGroup other(2);
+  EXPECT_FALSE(other.listen(port));
+
+  loops.shutdown();
+  loops.run();
+}
+
+} } // namespace hyrise::net
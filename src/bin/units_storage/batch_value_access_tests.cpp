@@ -0,0 +1,85 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <algorithm>
+
+#include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "storage/TableRangeView.h"
+
+namespace hyrise {
+namespace storage {
+
+class BatchValueAccessTests : public ::hyrise::Test {
+ protected:
+  // Compares the batched accessors with getValueId for all rows of a column
+  void expectSameValueIds(const c_atable_ptr_t& table, const size_t column) {
+    const size_t size = table->size();
+    std::vector<ValueId> range(size);
+    table->getValueIdRange(column, 0, size, range.data());
+
+    pos_list_t rows(size);
+    for (size_t i = 0; i < size; ++i) rows[i] = size - 1 - i;
+    std::vector<ValueId> at(size);
+    table->getValueIdsAt(column, rows.data(), size, at.data());
+
+    for (size_t row = 0; row < size; ++row) {
+      const auto expected = table->getValueId(column, row);
+      ASSERT_EQ(expected.valueId, range[row].valueId);
+      ASSERT_EQ(expected.table, range[row].table);
+      ASSERT_EQ(expected.valueId, at[size - 1 - row].valueId);
+      ASSERT_EQ(expected.table, at[size - 1 - row].table);
+    }
+  }
+};
+
+TEST_F(BatchValueAccessTests, table_and_store) {
+  auto t = io::Loader::shortcuts::load("test/test10k_12.tbl");
+  expectSameValueIds(t, 0);
+  expectSameValueIds(t, 5);
+  expectSameValueIds(std::dynamic_pointer_cast<Store>(t)->getMainTable(), 3);
+}
+
+TEST_F(BatchValueAccessTests, store_with_delta) {
+  auto s = io::Loader::shortcuts::loadMainDelta("test/merge1_main.tbl", "test/merge1_delta.tbl");
+  ASSERT_GT(s->getDeltaTable()->size(), 0u);
+  for (size_t column = 0; column < s->columnCount(); ++column) {
+    expectSameValueIds(s, column);
+  }
+
+  std::vector<hyrise_string_t> values(s->size());
+  s->getValueRange<hyrise_string_t>(2, 0, s->size(), values.data());
+  for (size_t row = 0; row < s->size(); ++row) {
+    ASSERT_EQ(s->getValue<hyrise_string_t>(2, row), values[row]);
+  }
+}
+
+TEST_F(BatchValueAccessTests, mutable_vertical_table) {
+  auto t = io::Loader::shortcuts::load("test/tables/partitions.tbl");
+  for (size_t column = 0; column < t->columnCount(); ++column) {
+    expectSameValueIds(t, column);
+  }
+}
+
+TEST_F(BatchValueAccessTests, pointer_calculator_and_range_view) {
+  auto t = io::Loader::shortcuts::load("test/test10k_12.tbl");
+
+  // every third row is stored as a compact bitmap
+  pos_list_t* positions = new pos_list_t;
+  for (pos_t p = 0; p < t->size(); p += 3) positions->push_back(p);
+  auto pc = PointerCalculator::create(t, positions);
+  ASSERT_NE(nullptr, pc->getCompactPositions());
+  expectSameValueIds(pc, 2);
+
+  auto view = TableRangeView::create(t, 100, 5000);
+  expectSameValueIds(view, 2);
+
+  std::vector<hyrise_int_t> values(pc->size());
+  pc->getValueRange<hyrise_int_t>(1, 0, pc->size(), values.data());
+  for (size_t row = 0; row < pc->size(); ++row) {
+    ASSERT_EQ(pc->getValue<hyrise_int_t>(1, row), values[row]);
+  }
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,106 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "storage/CompactPositionList.h"
+
+namespace hyrise {
+namespace storage {
+
+class CompactPositionListTests : public ::hyrise::Test {
+ protected:
+  pos_list_t every(size_t step, size_t count, pos_t offset = 0) {
+    pos_list_t result;
+    for (size_t i = 0; i < count; ++i) {
+      result.push_back(offset + i * step);
+    }
+    return result;
+  }
+};
+
+TEST_F(CompactPositionListTests, small_lists_stay_plain) {
+  ASSERT_EQ(nullptr, CompactPositionList::compact(every(1, 10)));
+}
+
+TEST_F(CompactPositionListTests, contiguous_positions_become_range) {
+  auto positions = every(1, 5000, 42);
+  auto c = CompactPositionList::compact(positions);
+  ASSERT_NE(nullptr, c);
+  ASSERT_EQ(CompactPositionList::Representation::Range, c->representation());
+  ASSERT_EQ(positions, c->materialize());
+  ASSERT_EQ(42u + 4999u, c->at(4999));
+}
+
+TEST_F(CompactPositionListTests, dense_positions_become_bitmap) {
+  auto positions = every(3, 100000, 7);
+  auto c = CompactPositionList::compact(positions);
+  ASSERT_EQ(CompactPositionList::Representation::Bitmap, c->representation());
+  ASSERT_EQ(positions.size(), c->size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    ASSERT_EQ(positions[i], c->at(i));
+  }
+  ASSERT_EQ(positions, c->materialize());
+  ASSERT_LT(c->memoryUsage(), positions.size() * sizeof(uint32_t));
+}
+
+TEST_F(CompactPositionListTests, sparse_positions_become_narrow) {
+  auto positions = every(1000, 5000);
+  std::reverse(positions.begin(), positions.end());
+  auto c = CompactPositionList::compact(positions);
+  ASSERT_EQ(CompactPositionList::Representation::Narrow, c->representation());
+  ASSERT_FALSE(c->isSorted());
+  ASSERT_EQ(positions, c->materialize());
+}
+
+TEST_F(CompactPositionListTests, intersect_and_unite_bitmaps) {
+  auto a = CompactPositionList::compact(every(2, 10000));
+  auto b = CompactPositionList::compact(every(3, 10000));
+
+  pos_list_t expected_intersection, expected_union;
+  auto la = a->materialize(), lb = b->materialize();
+  std::set_intersection(la.begin(), la.end(), lb.begin(), lb.end(), std::back_inserter(expected_intersection));
+  std::set_union(la.begin(), la.end(), lb.begin(), lb.end(), std::back_inserter(expected_union));
+
+  ASSERT_EQ(expected_intersection, CompactPositionList::intersect(*a, *b)->materialize());
+  ASSERT_EQ(expected_union, CompactPositionList::unite(*a, *b)->materialize());
+}
+
+TEST_F(CompactPositionListTests, intersect_range_with_bitmap) {
+  auto range = CompactPositionList::fromRange(1000, 3000);
+  auto bitmap = CompactPositionList::compact(every(2, 10000, 1));
+
+  pos_list_t expected;
+  for (pos_t p = 1001; p < 4000; p += 2) expected.push_back(p);
+  ASSERT_EQ(expected, CompactPositionList::intersect(*range, *bitmap)->materialize());
+}
+
+TEST_F(CompactPositionListTests, builder_switches_to_bitmap) {
+  PositionListBuilder builder(100000);
+  pos_list_t expected;
+  for (pos_t p = 0; p < 100000; p += 2) {
+    builder.push_back(p);
+    expected.push_back(p);
+  }
+
+  std::unique_ptr<CompactPositionList> compact;
+  pos_list_t* wide;
+  builder.build(compact, wide);
+  ASSERT_EQ(nullptr, wide);
+  ASSERT_EQ(CompactPositionList::Representation::Bitmap, compact->representation());
+  ASSERT_EQ(expected, compact->materialize());
+}
+
+TEST_F(CompactPositionListTests, builder_keeps_small_lists_plain) {
+  PositionListBuilder builder(100);
+  builder.push_back(3);
+  builder.push_back(17);
+
+  std::unique_ptr<CompactPositionList> compact;
+  pos_list_t* wide;
+  builder.build(compact, wide);
+  ASSERT_EQ(nullptr, compact);
+  ASSERT_EQ(pos_list_t({3, 17}), *wide);
+  delete wide;
+}
+
+} } // namespace hyrise::storage
+
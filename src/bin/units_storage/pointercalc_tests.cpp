@@ -100,5 +100,39 @@ TEST_F(PointerCalcTests, pc_on_selected_columns) {
   ASSERT_TRUE(pc->metadataAt(3).matches(t->metadataAt(7)));
 }
 
+TEST_F(PointerCalcTests, pc_compacts_dense_positions) {
+  atable_ptr_t t = io::Loader::shortcuts::load("test/test10k_12.tbl");
+
+  pos_list_t positions;
+  for (pos_t p = 0; p < t->size(); p += 2) {
+    positions.push_back(p);
+  }
+
+  auto pc = PointerCalculator::create(t, new pos_list_t(positions));
+  ASSERT_NE(nullptr, pc->getCompactPositions());
+  ASSERT_EQ(positions.size(), pc->size());
+  for (size_t row = 0; row < pc->size(); ++row) {
+    ASSERT_EQ(t->getValueId(0, positions[row]).valueId, pc->getValueId(0, row).valueId);
+  }
+  ASSERT_EQ(positions, *pc->getPositions());
+}
+
+TEST_F(PointerCalcTests, pc_intersect_compact_positions) {
+  atable_ptr_t t = io::Loader::shortcuts::load("test/test10k_12.tbl");
+
+  pos_list_t even, range;
+  for (pos_t p = 0; p < t->size(); p += 2) even.push_back(p);
+  for (pos_t p = 1000; p < 3000; ++p) range.push_back(p);
+
+  auto left = PointerCalculator::create(t, new pos_list_t(even));
+  auto right = PointerCalculator::create(t, new pos_list_t(range));
+  ASSERT_EQ(CompactPositionList::Representation::Range, right->getCompactPositions()->representation());
+
+  auto result = left->intersect(right);
+  ASSERT_EQ(1000u, result->size());
+  ASSERT_EQ(1000u, result->getTableRowForRow(0));
+  ASSERT_EQ(2998u, result->getTableRowForRow(999));
+}
+
 } } // namespace hyrise::storage
 
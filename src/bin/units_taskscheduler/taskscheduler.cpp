@@ -4,6 +4,8 @@
 #include <iterator>
 #include <ctime>
 #include <sys/time.h>
+#include <stdexcept>
+#include <thread>
 
 #include "testing/test.h"
 
@@ -12,8 +14,10 @@
 #include "taskscheduler/SharedScheduler.h"
 #include "taskscheduler/CoreBoundQueuesScheduler.h"
 #include "taskscheduler/WSCoreBoundQueuesScheduler.h"
+#include "taskscheduler/NodeBoundQueuesScheduler.h"
 #include "taskscheduler/ThreadPerTaskScheduler.h"
 #include "taskscheduler/DynamicPriorityScheduler.h"
+#include "taskscheduler/FairSharePriorityScheduler.h"
 
 #include "helper/HwlocHelper.h"
 
@@ -29,13 +33,15 @@ using ::testing::ValuesIn;
 // list schedulers to be tested
 std::vector<std::string> getSchedulersToTest() {
  return {"WSCoreBoundQueuesScheduler",
+           "NodeBoundQueuesScheduler",
            "CoreBoundQueuesScheduler",
            "CentralScheduler",
            "CentralPriorityScheduler",
            "CoreBoundPriorityQueuesScheduler",
            "WSCoreBoundPriorityQueuesScheduler",
            "ThreadPerTaskScheduler",
-           "DynamicPriorityScheduler"};
+           "DynamicPriorityScheduler",
+           "FairSharePriorityScheduler"};
 }
 
 class SchedulerTest : public TestWithParam<std::string> {
@@ -265,5 +271,125 @@ TEST(SchedulerBlockTest, dont_block_test_with_work_stealing) {
   long_block_test(scheduler.get());
 }
 
-} } // namespace hyrise::taskscheduler
+TEST(SchedulerBlockTest, dont_block_test_with_node_bound_queues) {
+  auto scheduler = std::make_shared<NodeBoundQueuesScheduler>(2);
+  long_block_test(scheduler.get());
+}
+
+TEST(SchedulerBlockTest, dont_block_test_with_fair_share) {
+  auto scheduler = std::make_shared<FairSharePriorityScheduler>(2);
+  long_block_test(scheduler.get());
+}
+
+TEST(NodeBoundQueuesSchedulerTest, tasks_carry_their_node) {
+  auto scheduler = std::make_shared<NodeBoundQueuesScheduler>(getNumberOfCoresOnSystem());
+  const int nodes = scheduler->getNumberOfNodes();
+  auto waiter = std::make_shared<WaitTask>();
+  std::vector<std::shared_ptr<access::NoOp> > hinted;
+  for (int node = 0; node < nodes; ++node) {
+    if (scheduler->getQueuesOfNode(node).empty())
+      continue;
+    hinted.push_back(std::make_shared<access::NoOp>());
+    hinted.back()->setPreferredNode(node);
+    waiter->addDependency(hinted.back());
+  }
+  // successors inherit the node of their dependency
+  auto successor = std::make_shared<access::NoOp>();
+  successor->addDependency(hinted.front());
+  waiter->addDependency(successor);
+
+  scheduler->schedule(successor);
+  for (const auto& task : hinted)
+    scheduler->schedule(task);
+  scheduler->schedule(waiter);
+  waiter->wait();
+
+  // idle nodes may steal hinted tasks, so only check they ran on some node
+  for (const auto& task : hinted) {
+    EXPECT_LE(0, task->getActualNode());
+    EXPECT_GT(nodes, task->getActualNode());
+  }
+  EXPECT_EQ(hinted.front()->getActualNode(), successor->getPreferredNode());
+  EXPECT_LE(0, successor->getActualNode());
+  EXPECT_GT(nodes, successor->getActualNode());
+}
+
+std::shared_ptr<access::NoOp> queryTask(int priority, int session, tx::transaction_id_t id = 0, const std::string& queryId = "") {
+  auto task = std::make_shared<access::NoOp>();
+  task->setPriority(priority);
+  task->setSessionId(session);
+  task->setId(id);
+  task->setQueryId(queryId);
+  return task;
+}
+
+TEST(FairShareQueueTest, classes_run_by_share) {
+  FairShareQueue queue;
+  queue.setShare(0, 3);
+  queue.setShare(1, 1);
+  for (int i = 0; i < 8; ++i) {
+    queue.push(queryTask(0, 1));
+    queue.push(queryTask(1, 2));
+  }
+  int high = 0;
+  for (int i = 0; i < 8; ++i)
+    high += (queue.pop()->getPriority() == 0);
+  EXPECT_EQ(6, high);
+  EXPECT_EQ(8u, queue.size());
+}
+
+TEST(FairShareQueueTest, queries_of_a_class_share_equally) {
+  FairShareQueue queue;
+  // a large query is ready first, a small one of another session follows
+  for (int i = 0; i < 100; ++i)
+    queue.push(queryTask(1, 1));
+  queue.push(queryTask(1, 2));
+  queue.push(queryTask(1, 2));
+  int small = 0;
+  for (int i = 0; i < 4; ++i)
+    small += (queue.pop()->getSessionId() == 2);
+  EXPECT_EQ(2, small);
+}
+
+TEST(FairShareQueueTest, queries_without_session_are_told_apart_by_transaction) {
+  FairShareQueue queue;
+  for (int i = 0; i < 10; ++i)
+    queue.push(queryTask(1, Task::SESSION_ID_NOT_SET, 7));
+  queue.push(queryTask(1, Task::SESSION_ID_NOT_SET, 8));
+  queue.pop();
+  EXPECT_EQ(8, queue.pop()->getId());
+}
 
+TEST(FairShareQueueTest, snapshot_queries_are_told_apart_by_query_id) {
+  // read-only autocommit queries all run with the read-only transaction id
+  const tx::transaction_id_t snapshotId = tx::READ_ONLY_TID;
+  FairShareQueue queue;
+  for (int i = 0; i < 10; ++i)
+    queue.push(queryTask(1, Task::SESSION_ID_NOT_SET, snapshotId, "snapshot-1"));
+  queue.push(queryTask(1, Task::SESSION_ID_NOT_SET, snapshotId, "snapshot-2"));
+  queue.pop();
+  EXPECT_EQ("snapshot-2", queue.pop()->getQueryId());
+}
+
+TEST(FairShareQueueTest, waiting_tasks_age) {
+  FairShareQueue queue;
+  queue.setShare(0, 1000);
+  queue.setShare(1, 0.001);
+  queue.setAgingThreshold(std::chrono::milliseconds(5));
+  auto starving = queryTask(1, 2);
+  queue.push(queryTask(0, 1));
+  queue.push(starving);
+  for (int i = 0; i < 10; ++i)
+    queue.push(queryTask(0, 1));
+  EXPECT_NE(starving, queue.pop()) << "Not waiting long enough to be aged";
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(starving, queue.pop());
+}
+
+TEST(FairShareQueueTest, rejects_shares_without_cpu) {
+  FairShareQueue queue;
+  EXPECT_THROW(queue.setShare(0, 0), std::invalid_argument);
+  EXPECT_EQ(FairShareQueue::defaultShare, queue.getShare(0));
+}
+
+} } // namespace hyrise::taskscheduler
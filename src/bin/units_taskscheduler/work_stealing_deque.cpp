@@ -0,0 +1,87 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "testing/test.h"
+
+#include "taskscheduler/WorkStealingDeque.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+TEST(WorkStealingDequeTest, owner_pops_last_thief_steals_first) {
+  WorkStealingDeque<int *> deque(4);
+  int items[3];
+  for (auto& item : items)
+    deque.push(&item);
+
+  int *item;
+  ASSERT_TRUE(deque.steal(item));
+  EXPECT_EQ(&items[0], item);
+  ASSERT_TRUE(deque.pop(item));
+  EXPECT_EQ(&items[2], item);
+  ASSERT_TRUE(deque.pop(item));
+  EXPECT_EQ(&items[1], item);
+  EXPECT_FALSE(deque.pop(item));
+  EXPECT_FALSE(deque.steal(item));
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, grows_beyond_capacity) {
+  WorkStealingDeque<size_t *> deque(2);
+  std::vector<size_t> items(100);
+  for (size_t i = 0; i < items.size(); ++i) {
+    items[i] = i;
+    deque.push(&items[i]);
+  }
+  EXPECT_EQ(items.size(), deque.size());
+
+  size_t *item;
+  for (size_t i = 0; i < items.size(); ++i) {
+    ASSERT_TRUE(deque.steal(item));
+    EXPECT_EQ(i, *item);
+  }
+  EXPECT_FALSE(deque.steal(item));
+}
+
+TEST(WorkStealingDequeTest, every_item_is_taken_once) {
+  const size_t numberOfItems = 100000;
+  const size_t thieves = 3;
+  WorkStealingDeque<size_t *> deque(16);
+  std::vector<size_t> items(numberOfItems);
+  std::vector<std::atomic<size_t> > taken(numberOfItems);
+  for (auto& t : taken)
+    t = 0;
+  std::atomic<bool> done(false);
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thieves; ++i) {
+    threads.emplace_back([&]() {
+      size_t *item;
+      while (!done || !deque.empty()) {
+        if (deque.steal(item))
+          ++taken[*item];
+      }
+    });
+  }
+
+  // the owner pushes and pops alternately to race with the thieves
+  size_t *item;
+  for (size_t i = 0; i < numberOfItems; ++i) {
+    items[i] = i;
+    deque.push(&items[i]);
+    if (i % 3 == 0 && deque.pop(item))
+      ++taken[*item];
+  }
+  while (deque.pop(item))
+    ++taken[*item];
+  done = true;
+  for (auto& thread : threads)
+    thread.join();
+
+  for (size_t i = 0; i < numberOfItems; ++i)
+    ASSERT_EQ(1u, taken[i]) << "item " << i;
+}
+
+} } // namespace hyrise::taskscheduler
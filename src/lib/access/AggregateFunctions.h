@@ -61,6 +61,8 @@ class AggregateFun {
     _new_field_name = name;
   }
   virtual std::string defaultColumnName(const std::string &oldName) = 0;
+  /// Copy for a further instance of the GroupByScan
+  virtual AggregateFun *clone() const = 0;
   
  protected:
   field_t  _field;
@@ -98,6 +100,10 @@ class SumAggregateFun: public AggregateFun {
     }
   }
 
+  virtual AggregateFun *clone() const {
+    return new SumAggregateFun(*this);
+  }
+
   virtual std::string defaultColumnName(const std::string &oldName) {
     return "SUM(" + oldName + ")";
   }
@@ -135,6 +141,10 @@ class CountAggregateFun: public AggregateFun {
     return IntegerType;
   }
 
+  virtual AggregateFun *clone() const {
+    return new CountAggregateFun(*this);
+  }
+
   virtual std::string defaultColumnName(const std::string &oldName) {
     if (isDistinct())
       return "COUNT(DISTINCT " + oldName + ")";
@@ -173,6 +183,10 @@ class AverageAggregateFun: public AggregateFun {
     }
   }
 
+  virtual AggregateFun *clone() const {
+    return new AverageAggregateFun(*this);
+  }
+
   virtual std::string defaultColumnName(const std::string &oldName) {
     return "AVG(" + oldName + ")";
   }
@@ -206,6 +220,10 @@ class MinAggregateFun: public AggregateFun {
     _dataType = table.typeOfColumn(_field);
   }
 
+  virtual AggregateFun *clone() const {
+    return new MinAggregateFun(*this);
+  }
+
   virtual std::string defaultColumnName(const std::string &oldName) {
     return "MIN(" + oldName + ")";
   }
@@ -239,6 +257,10 @@ class MaxAggregateFun: public AggregateFun {
     _dataType = table.typeOfColumn(_field);
   }
 
+  virtual AggregateFun *clone() const {
+    return new MaxAggregateFun(*this);
+  }
+
   virtual std::string defaultColumnName(const std::string &oldName) {
     return "MAX(" + oldName + ")";
   }
@@ -0,0 +1,365 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/BulkInsert.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "access/system/BinaryResponse.h"
+#include "access/system/QueryParser.h"
+#include "access/system/ResponseTask.h"
+
+#include "helper/checked_cast.h"
+#include "helper/make_unique.h"
+
+#include "io/TransactionManager.h"
+
+#include "storage/BaseDictionary.h"
+#include "storage/Store.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+auto _ = QueryParser::registerPlanOperation<BulkInsert>("BulkInsert");
+
+size_t align(size_t offset) {
+  return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+// Bounds checked reading of the binary columnar encoding
+class BinaryReader {
+ public:
+  explicit BinaryReader(const std::string &data) : _data(data), _offset(0) {}
+
+  const char *take(size_t bytes) {
+    if (bytes > _data.size() - _offset) {
+      throw std::runtime_error("BulkInsert: binary payload is truncated");
+    }
+    const char *result = _data.data() + _offset;
+    _offset += bytes;
+    return result;
+  }
+
+  template <typename V>
+  V read() {
+    V value;
+    std::memcpy(&value, take(sizeof(V)), sizeof(V));
+    return value;
+  }
+
+  void skipPadding() {
+    take(align(_offset) - _offset);
+  }
+
+ private:
+  const std::string &_data;
+  size_t _offset;
+};
+
+/*
+ * Decoded values of one column. write inserts every distinct value into
+ * the dictionary once and sets the value-ids of the rows directly.
+ */
+class ColumnValues {
+ public:
+  virtual ~ColumnValues() {}
+  virtual void parse(const std::string &field) = 0;
+  virtual void read(BinaryReader &reader, uint32_t type, size_t rows) = 0;
+  virtual void write(const storage::atable_ptr_t &delta, size_t column, size_t first) const = 0;
+  virtual size_t size() const = 0;
+};
+
+template <typename T>
+T parseField(const std::string &field, typename std::enable_if<std::is_integral<T>::value>::type* = 0) {
+  char *end = nullptr;
+  const T value = std::strtoll(field.c_str(), &end, 10);
+  if (field.empty() || *end != '\0') {
+    throw std::runtime_error("BulkInsert: '" + field + "' is no integer");
+  }
+  return value;
+}
+
+template <typename T>
+T parseField(const std::string &field, typename std::enable_if<std::is_floating_point<T>::value>::type* = 0) {
+  char *end = nullptr;
+  const T value = std::strtod(field.c_str(), &end);
+  if (field.empty() || *end != '\0') {
+    throw std::runtime_error("BulkInsert: '" + field + "' is no float");
+  }
+  return value;
+}
+
+template <typename T>
+T parseField(const std::string &field, typename std::enable_if<std::is_same<T, hyrise_string_t>::value>::type* = 0) {
+  return field;
+}
+
+template <typename T, typename S>
+void readNumbers(BinaryReader &reader, size_t rows, std::vector<T> &values) {
+  const char *data = reader.take(rows * sizeof(S));
+  values.reserve(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    S value;
+    std::memcpy(&value, data + i * sizeof(S), sizeof(S));
+    values.push_back(static_cast<T>(value));
+  }
+  reader.skipPadding();
+}
+
+template <typename T>
+void readColumn(BinaryReader &reader, uint32_t type, size_t rows, std::vector<T> &values,
+                typename std::enable_if<std::is_integral<T>::value>::type* = 0) {
+  if (type == BinaryInt) {
+    readNumbers<T, hyrise_int_t>(reader, rows, values);
+  } else if (type == BinaryInt32) {
+    readNumbers<T, hyrise_int32_t>(reader, rows, values);
+  } else {
+    throw std::runtime_error("BulkInsert: expected an integer column");
+  }
+}
+
+template <typename T>
+void readColumn(BinaryReader &reader, uint32_t type, size_t rows, std::vector<T> &values,
+                typename std::enable_if<std::is_floating_point<T>::value>::type* = 0) {
+  if (type != BinaryFloat) {
+    throw std::runtime_error("BulkInsert: expected a float column");
+  }
+  readNumbers<T, hyrise_float_t>(reader, rows, values);
+}
+
+template <typename T>
+void readColumn(BinaryReader &reader, uint32_t type, size_t rows, std::vector<T> &values,
+                typename std::enable_if<std::is_same<T, hyrise_string_t>::value>::type* = 0) {
+  if (type != BinaryString) {
+    throw std::runtime_error("BulkInsert: expected a string column");
+  }
+  std::vector<uint64_t> offsets(rows + 1);
+  std::memcpy(offsets.data(), reader.take(offsets.size() * sizeof(uint64_t)), offsets.size() * sizeof(uint64_t));
+  for (size_t i = 0; i < rows; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      throw std::runtime_error("BulkInsert: invalid string offsets");
+    }
+  }
+  const char *data = reader.take(offsets[rows] - offsets[0]);
+  values.reserve(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    values.emplace_back(data + offsets[i] - offsets[0], offsets[i + 1] - offsets[i]);
+  }
+  reader.skipPadding();
+}
+
+template <typename T>
+class TypedColumnValues : public ColumnValues {
+ public:
+  virtual void parse(const std::string &field) {
+    _values.push_back(parseField<T>(field));
+  }
+
+  virtual void read(BinaryReader &reader, uint32_t type, size_t rows) {
+    readColumn(reader, type, rows, _values);
+  }
+
+  virtual void write(const storage::atable_ptr_t &delta, size_t column, size_t first) const {
+    const auto& dict = checked_pointer_cast<storage::BaseDictionary<T>>(delta->dictionaryAt(column, first));
+    // Value-ids of the values already inserted by this batch
+    std::unordered_map<T, value_id_t> valueIds;
+    ValueId valueId;
+    valueId.table = 0;
+    for (size_t i = 0, rows = _values.size(); i < rows; ++i) {
+      auto it = valueIds.find(_values[i]);
+      if (it == valueIds.end()) {
+        it = valueIds.emplace(_values[i], dict->insert(_values[i])).first;
+      }
+      valueId.valueId = it->second;
+      delta->setValueId(column, first + i, valueId);
+    }
+  }
+
+  virtual size_t size() const {
+    return _values.size();
+  }
+
+ private:
+  std::vector<T> _values;
+};
+
+struct column_values_functor {
+  typedef std::unique_ptr<ColumnValues> value_type;
+
+  template <typename T>
+  value_type operator()() {
+    return make_unique<TypedColumnValues<T>>();
+  }
+};
+
+typedef std::vector<std::unique_ptr<ColumnValues>> columns_t;
+
+columns_t createColumns(const storage::c_atable_ptr_t &table) {
+  storage::type_switch<hyrise_basic_types> ts;
+  column_values_functor fun;
+  columns_t columns;
+  for (size_t column = 0; column < table->columnCount(); ++column) {
+    columns.push_back(ts(table->typeOfColumn(column), fun));
+  }
+  return columns;
+}
+
+void decodeCSV(const std::string &csv, const char separator, columns_t &columns) {
+  std::string field;
+  size_t column = 0;
+  size_t line = 1;
+  bool quoted = false;
+  bool emptyRow = true;
+
+  auto endField = [&] () {
+    if (column == columns.size()) {
+      throw std::runtime_error("BulkInsert: line " + std::to_string(line) + " has more than " +
+                               std::to_string(columns.size()) + " fields");
+    }
+    columns[column++]->parse(field);
+    field.clear();
+  };
+
+  auto endRow = [&] () {
+    if (!emptyRow) {
+      endField();
+      if (column != columns.size()) {
+        throw std::runtime_error("BulkInsert: line " + std::to_string(line) + " has only " +
+                                 std::to_string(column) + " fields");
+      }
+    }
+    column = 0;
+    emptyRow = true;
+    ++line;
+  };
+
+  for (size_t i = 0, size = csv.size(); i < size; ++i) {
+    const char c = csv[i];
+    if (quoted) {
+      if (c != '"') {
+        field.push_back(c);
+        line += (c == '\n') ? 1 : 0;
+      } else if (i + 1 < size && csv[i + 1] == '"') {
+        field.push_back('"');
+        ++i;
+      } else {
+        quoted = false;
+      }
+    } else if (c == separator) {
+      emptyRow = false;
+      endField();
+    } else if (c == '\n') {
+      endRow();
+    } else if (c == '"' && field.empty()) {
+      emptyRow = false;
+      quoted = true;
+    } else if (c != '\r') {
+      emptyRow = false;
+      field.push_back(c);
+    }
+  }
+  if (quoted) {
+    throw std::runtime_error("BulkInsert: unterminated quoted field in line " + std::to_string(line));
+  }
+  endRow();
+}
+
+void decodeBinary(const std::string &binary, columns_t &columns) {
+  BinaryReader reader(binary);
+  if (std::memcmp(reader.take(4), "HYRC", 4) != 0) {
+    throw std::runtime_error("BulkInsert: binary payload does not start with HYRC");
+  }
+  if (reader.read<uint32_t>() != binaryResponseVersion) {
+    throw std::runtime_error("BulkInsert: unsupported binary format version");
+  }
+  const uint32_t metadataLength = reader.read<uint32_t>();
+  const uint32_t columnCount = reader.read<uint32_t>();
+  const uint64_t rows = reader.read<uint64_t>();
+  if (columnCount != columns.size()) {
+    throw std::runtime_error("BulkInsert: payload has " + std::to_string(columnCount) + " columns, table has " +
+                             std::to_string(columns.size()));
+  }
+  // Every value takes at least four bytes
+  if (columnCount > 0 && rows > binary.size() / 4) {
+    throw std::runtime_error("BulkInsert: binary payload is truncated");
+  }
+  reader.take(metadataLength);
+  reader.skipPadding();
+
+  std::vector<uint32_t> types;
+  for (size_t column = 0; column < columnCount; ++column) {
+    types.push_back(reader.read<uint32_t>());
+    reader.take(reader.read<uint32_t>());
+    reader.skipPadding();
+  }
+
+  for (size_t column = 0; column < columnCount; ++column) {
+    columns[column]->read(reader, types[column], rows);
+  }
+}
+
+}  // namespace
+
+void BulkInsert::setCSV(std::string csv, char separator) {
+  _format = CSV;
+  _payload = std::move(csv);
+  _separator = separator;
+}
+
+void BulkInsert::setBinary(std::string binary) {
+  _format = Binary;
+  _payload = std::move(binary);
+}
+
+void BulkInsert::executePlanOperation() {
+  const auto& c_store = checked_pointer_cast<const storage::Store>(input.getTable(0));
+  // Cast the constness away
+  auto store = std::const_pointer_cast<storage::Store>(c_store);
+
+  auto columns = createColumns(store);
+  if (_format == Binary) {
+    decodeBinary(_payload, columns);
+  } else {
+    decodeCSV(_payload, _separator, columns);
+  }
+  _insertedRows = columns.empty() ? 0 : columns.front()->size();
+
+  if (_insertedRows > 0) {
+    auto writeArea = store->appendToDelta(_insertedRows);
+    const auto& delta = store->getDeltaTable();
+    for (size_t column = 0; column < columns.size(); ++column) {
+      columns[column]->write(delta, column, writeArea.first);
+    }
+
+    const size_t firstPosition = store->getMainTable()->size() + writeArea.first;
+    for (size_t i = 0; i < _insertedRows; ++i) {
+      store->setTid(firstPosition + i, _txContext.tid);
+    }
+    tx::TransactionManager::getInstance()[_txContext.tid].insertPosRange(store, firstPosition, _insertedRows);
+  }
+
+  auto rsp = getResponseTask();
+  if (rsp != nullptr)
+    rsp->incAffectedRows(_insertedRows);
+
+  addResult(input.getTable(0));
+}
+
+std::shared_ptr<PlanOperation> BulkInsert::parse(const Json::Value &data) {
+  auto result = std::make_shared<BulkInsert>();
+  const std::string separator = data.get("separator", "|").asString();
+  if (separator.size() != 1) {
+    throw std::runtime_error("BulkInsert: separator must be a single character");
+  }
+  result->setCSV(data["csv"].asString(), separator[0]);
+  return result;
+}
+
+}
+}
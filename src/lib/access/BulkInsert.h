@@ -0,0 +1,51 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_BULKINSERT_H_
+#define SRC_LIB_ACCESS_BULKINSERT_H_
+
+#include <string>
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Appends many rows to the delta of the input store at once. The rows
+ * are given as CSV text or in the binary columnar encoding of query
+ * results (see BinaryResponse.h), with one value for every column of the
+ * store. The rows are decoded column by column, every distinct value is
+ * inserted into the delta dictionary once and the value-ids are written
+ * directly into the delta range reserved by a single appendToDelta.
+ *
+ * {
+ *   "type": "BulkInsert",
+ *   "csv": "1|Ada\n2|Grace",
+ *   "separator": "|"
+ * }
+ */
+class BulkInsert : public PlanOperation {
+ public:
+  enum Format { CSV, Binary };
+
+  void executePlanOperation();
+  bool isModifying() const { return true; }
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
+
+  /// CSV fields are separated by `separator` and may be enclosed in
+  /// double quotes, rows are separated by line breaks
+  void setCSV(std::string csv, char separator = '|');
+  void setBinary(std::string binary);
+
+  size_t getInsertedRows() const { return _insertedRows; }
+
+ private:
+  Format _format = CSV;
+  std::string _payload;
+  char _separator = '|';
+  size_t _insertedRows = 0;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_BULKINSERT_H_
@@ -0,0 +1,67 @@
+#include "access/BulkInsertHandler.h"
+
+#include "json.h"
+#include "net/AbstractConnection.h"
+#include "access/BulkInsert.h"
+#include "access/system/BinaryResponse.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+const std::string bulkInsertRoute = "/bulk/";
+}
+
+bool BulkInsertHandler::registered =
+    net::Router::registerRoute<BulkInsertHandler>(bulkInsertRoute);
+
+BulkInsertHandler::BulkInsertHandler(net::AbstractConnection *data)
+    : _connection_data(data) {}
+
+std::string BulkInsertHandler::name() {
+  return "BulkInsertHandler";
+}
+
+const std::string BulkInsertHandler::vname() {
+  return "BulkInsertHandler";
+}
+
+std::string BulkInsertHandler::constructResponse() {
+  Json::Value result;
+  const std::string path = _connection_data->getPath();
+  const size_t start = path.find(bulkInsertRoute) + bulkInsertRoute.size();
+  const std::string table = path.substr(start, path.find_first_of("/?", start) - start);
+
+  auto ctx = tx::TransactionManager::beginTransaction();
+  try {
+    auto insert = std::make_shared<BulkInsert>();
+    insert->setTXContext(ctx);
+    insert->addInput(io::StorageManager::getInstance()->getTable(table));
+
+    const std::string contentType = _connection_data->getHeader("Content-Type");
+    if (contentType.compare(0, sizeof(binaryResponseContentType) - 1, binaryResponseContentType) == 0) {
+      insert->setBinary(_connection_data->getBody());
+    } else {
+      const std::string separator = _connection_data->getHeader("X-Hyrise-Separator");
+      insert->setCSV(_connection_data->getBody(), separator.empty() ? '|' : separator[0]);
+    }
+    insert->execute();
+
+    tx::TransactionManager::commitTransaction(ctx);
+    result["affectedRows"] = Json::Value((Json::UInt64) insert->getInsertedRows());
+  } catch (const std::exception &e) {
+    tx::TransactionManager::rollbackTransaction(ctx);
+    result["error"].append(Json::Value(e.what()));
+  }
+  Json::FastWriter writer;
+  return writer.write(result);
+}
+
+void BulkInsertHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+}
+}
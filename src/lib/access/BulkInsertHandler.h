@@ -0,0 +1,28 @@
+#ifndef SRC_LIB_ACCESS_BULKINSERTHANDLER_H
+#define SRC_LIB_ACCESS_BULKINSERTHANDLER_H
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net { class AbstractConnection; }
+namespace access {
+
+/// Appends the rows of the request body to the table named by the path
+/// (/bulk/<table>) in its own transaction, see BulkInsert. The body is
+/// CSV text, or the binary columnar encoding for the content type
+/// application/x-hyrise-columnar.
+class BulkInsertHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection *_connection_data;
+ public:
+  explicit BulkInsertHandler(net::AbstractConnection *data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+
+}}
+
+
+#endif
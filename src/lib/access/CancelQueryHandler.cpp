@@ -0,0 +1,45 @@
+#include "access/CancelQueryHandler.h"
+
+#include <map>
+
+#include "json.h"
+#include "net/AbstractConnection.h"
+#include "access/system/QueryCancellation.h"
+#include "helper/HttpHelper.h"
+
+namespace hyrise {
+namespace access {
+
+bool CancelQueryHandler::registered =
+    net::Router::registerRoute<CancelQueryHandler>("/cancel/");
+
+CancelQueryHandler::CancelQueryHandler(net::AbstractConnection *data)
+    : _connection_data(data) {}
+
+std::string CancelQueryHandler::name() {
+  return "CancelQueryHandler";
+}
+
+const std::string CancelQueryHandler::vname() {
+  return "CancelQueryHandler";
+}
+
+std::string CancelQueryHandler::constructResponse() {
+  Json::Value result;
+  if (!_connection_data->hasBody()) {
+    result["error"].append(Json::Value("no query_id given"));
+  } else {
+    std::map<std::string, std::string> body_data = parseHTTPFormData(_connection_data->getBody());
+    const std::string queryId = urldecode(body_data["query_id"]);
+    result["cancelled"] = Json::Value((Json::UInt64) RunningQueries::getInstance().cancel(queryId));
+  }
+  Json::FastWriter writer;
+  return writer.write(result);
+}
+
+void CancelQueryHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+}
+}
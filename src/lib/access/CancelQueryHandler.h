@@ -0,0 +1,26 @@
+#ifndef SRC_LIB_ACCESS_CANCELQUERYHANDLER_H
+#define SRC_LIB_ACCESS_CANCELQUERYHANDLER_H
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net { class AbstractConnection; }
+namespace access {
+
+/// Cancels the running queries with the query id given as `query_id`
+/// in the POST body, see RunningQueries
+class CancelQueryHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection *_connection_data;
+ public:
+  explicit CancelQueryHandler(net::AbstractConnection *data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+
+}}
+
+
+#endif
@@ -0,0 +1,34 @@
+#include "access/CostModelHandler.h"
+
+#include "json.h"
+#include "net/AbstractConnection.h"
+#include "access/system/CostModel.h"
+
+namespace hyrise {
+namespace access {
+
+bool CostModelHandler::registered =
+    net::Router::registerRoute<CostModelHandler>("/costmodels/");
+
+CostModelHandler::CostModelHandler(net::AbstractConnection *data)
+    : _connection_data(data) {}
+
+std::string CostModelHandler::name() {
+  return "CostModelHandler";
+}
+
+const std::string CostModelHandler::vname() {
+  return "CostModelHandler";
+}
+
+std::string CostModelHandler::constructResponse() {
+  Json::StyledWriter writer;
+  return writer.write(CostModels::getInstance().toJson());
+}
+
+void CostModelHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+}
+}
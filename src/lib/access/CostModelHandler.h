@@ -0,0 +1,25 @@
+#ifndef SRC_LIB_ACCESS_COSTMODELHANDLER_H
+#define SRC_LIB_ACCESS_COSTMODELHANDLER_H
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net { class AbstractConnection; }
+namespace access {
+
+/// Lists the cost models of dynamic parallelization learned on this host
+class CostModelHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection *_connection_data;
+ public:
+  explicit CostModelHandler(net::AbstractConnection *data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+
+}}
+
+
+#endif
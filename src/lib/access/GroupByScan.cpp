@@ -1,6 +1,9 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/GroupByScan.h"
 
+#include <stdexcept>
+
+#include "access/system/MorselCursor.h"
 #include "access/system/QueryParser.h"
 #include "storage/ColumnMetadata.h"
 #include "storage/DictionaryFactory.h"
@@ -155,7 +158,84 @@ void GroupByScan::addFunction(AggregateFun *fun) {
   this->_aggregate_functions.push_back(fun);
 }
 
+std::vector<taskscheduler::task_ptr_t> GroupByScan::applyDynamicParallelization(size_t dynamicCount) {
+  // morsels are groups, aggregations without groups run as one instance
+  const auto& hashTable = getGroupHashTable();
+  if (!hashTable || _indexed_field_definition.size() + _named_field_definition.size() == 0)
+    return {shared_from_this()};
+  auto tasks = applyMorselParallelization(dynamicCount, hashTable->numKeys());
+  if (_morsels)
+    findMorselStarts(hashTable, tasks);
+  return tasks;
+}
+
+void GroupByScan::findMorselStarts(const storage::c_ahashtable_ptr_t &hashTable,
+                                   const std::vector<taskscheduler::task_ptr_t> &instances) {
+  // the same hash table types executePlanOperation chooses from
+  if (!findMorselStarts<storage::SingleAggregateHashTable>(hashTable, instances) &&
+      !findMorselStarts<storage::AggregateHashTable>(hashTable, instances) &&
+      !findMorselStarts<storage::SingleJoinHashTable>(hashTable, instances) &&
+      !findMorselStarts<storage::JoinHashTable>(hashTable, instances))
+    throw std::runtime_error("GroupByScan cannot split the groups of this hash table type");
+}
+
+template<typename HashTableType>
+bool GroupByScan::findMorselStarts(const storage::c_ahashtable_ptr_t &hashTable,
+                                   const std::vector<taskscheduler::task_ptr_t> &instances) {
+  auto typedHashTable = std::dynamic_pointer_cast<const HashTableType>(hashTable);
+  if (!typedHashTable)
+    return false;
+
+  // walk the groups once instead of once per instance
+  auto morselStarts = std::make_shared<MorselStarts<HashTableType>>();
+  morselStarts->starts.reserve(_morsels->size() / _morsels->morselSize() + 1);
+  const auto end = typedHashTable->getMapEnd();
+  size_t key = 0;
+  for (auto it1 = typedHashTable->getMapBegin(), it2 = it1; it1 != end; ++key, it1 = it2) {
+    if (key % _morsels->morselSize() == 0)
+      morselStarts->starts.push_back(it1);
+    for (; (it2 != end) && (it1->first == it2->first); ++it2) {}
+  }
+
+  for (const auto& instance : instances) {
+    if (auto groupByScan = std::dynamic_pointer_cast<GroupByScan>(instance))
+      groupByScan->_morselStarts = morselStarts;
+  }
+  return true;
+}
+
+std::shared_ptr<ParallelizablePlanOperation> GroupByScan::createInstance() {
+  auto instance = std::make_shared<GroupByScan>();
+  instance->_indexed_field_definition = _indexed_field_definition;
+  instance->_named_field_definition = _named_field_definition;
+  for (const auto& function : _aggregate_functions)
+    instance->addFunction(function->clone());
+  instance->_globalAggregation = _globalAggregation;
+  return instance;
+}
+
+size_t GroupByScan::getTotalTableSize() {
+  for (const auto& dependency : _dependencies) {
+    const auto& table = std::dynamic_pointer_cast<PlanOperation>(dependency)->getResultTable();
+    if (table)
+      return table->size();
+  }
+  return 0;
+}
+
+storage::c_ahashtable_ptr_t GroupByScan::getGroupHashTable() {
+  for (const auto& dependency : _dependencies) {
+    const auto& hashTables = std::dynamic_pointer_cast<PlanOperation>(dependency)->getResultHashTables();
+    if (!hashTables.empty())
+      return hashTables[0];
+  }
+  return nullptr;
+}
+
 void GroupByScan::splitInput() {
+  // morsel-driven instances keep the whole hash table
+  if (_morsels)
+    return;
   hash_table_list_t hashTables = input.getHashTables();
   if (_count > 0 && !hashTables.empty()) {
     auto r = distribute(hashTables[0]->numKeys(), _part, _count);
@@ -188,11 +268,38 @@ void GroupByScan::executeGroupBy() {
   auto resultTab = createResultTableLayout();
 
   auto groupResults = getInputHashTable();
-  // Allocate some memory for the result tab and resize the table
-  resultTab->resize(groupResults->numKeys());
 
   pos_t row = 0;
   typename HashTableType::map_const_iterator_t it1, it2, end;
+  if (_morsels) {
+    // instances share the whole hash table and pull morsels of its keys,
+    // each morsel starts at the group found by applyDynamicParallelization
+    auto morselStarts = std::dynamic_pointer_cast<const MorselStarts<HashTableType>>(_morselStarts);
+    if (!morselStarts)
+      throw std::runtime_error("GroupByScan instance is missing the morsel starts of its hash table");
+    end = std::dynamic_pointer_cast<const HashTableType>(groupResults)->getMapEnd();
+    size_t key, first, last;
+    while (_morsels->next(first, last)) {
+      this->checkCancellation();
+      key = first;
+      it1 = morselStarts->starts.at(first / _morsels->morselSize());
+      resultTab->resize(row + last - first);
+      for (it2 = it1; key < last && it1 != end; ++key, it1 = it2) {
+        auto pos_list = std::make_shared<pos_list_t>();
+        for (; (it2 != end) && (it1->first == it2->first); ++it2) {
+          pos_list->push_back(it2->second);
+        }
+        writeGroupResult(resultTab, pos_list, row);
+        row++;
+      }
+    }
+    this->addResult(resultTab);
+    return;
+  }
+
+  // Allocate some memory for the result tab and resize the table
+  resultTab->resize(groupResults->numKeys());
+
   // set iterators: in the sequential case, getInputTable() returns an AggregateHashTable, in the parallel case a HashTableView<>
   // Alternatively, a common type could be introduced
   if (_count < 1) {
@@ -205,6 +312,9 @@ void GroupByScan::executeGroupBy() {
     end = hashTableView->getMapEnd();
   }
   for (it2 = it1; it1 != end; it1 = it2) {
+    if (row % cancellationCheckInterval == 0) {
+      this->checkCancellation();
+    }
     // outer loop over unique keys
     auto pos_list = std::make_shared<pos_list_t>();
     for (; (it2 != end) && (it1->first == it2->first); ++it2) {
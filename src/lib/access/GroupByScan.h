@@ -45,15 +45,48 @@ public:
   storage::atable_ptr_t createResultTableLayout();
   /// adds a given AggregateFunction to group by scan instance SUM or COUNT
   void addFunction(AggregateFun *fun);
+  /// Splits into instances pulling morsels of the groups, requires the
+  /// HashBuild to be done
+  virtual std::vector<taskscheduler::task_ptr_t> applyDynamicParallelization(size_t dynamicCount);
+
+protected:
+  std::shared_ptr<ParallelizablePlanOperation> createInstance();
+
+  // for determineDynamicCount
+  virtual size_t getTotalTableSize();
+  // No offline fit exists for the GroupByScan, it starts from the
+  // TableScan fit until the cost model learned the host
+  virtual double min_mts_a() { return 0.0552475752421333; }
+  virtual double min_mts_b() { return -0.0850757329978712; }
+  virtual double a_a() { return 3.38149153671817; }
+  virtual double a_b() { return 12.2562615548958; }
 
 private:
   void splitInput();
+  /// Input hash table of the groups, null if there is none
+  storage::c_ahashtable_ptr_t getGroupHashTable();
   void writeGroupResult(storage::atable_ptr_t &resultTab,
                         const std::shared_ptr<storage::pos_list_t> &hit,
                         const size_t row);
   /// Depending on the number of fields to group by choose the appropriate map type
   template<typename HashTableType, typename MapType, typename KeyType>
   void executeGroupBy();
+  /// Shares the first group of every morsel with the instances
+  void findMorselStarts(const storage::c_ahashtable_ptr_t &hashTable,
+                        const std::vector<taskscheduler::task_ptr_t> &instances);
+  template<typename HashTableType>
+  bool findMorselStarts(const storage::c_ahashtable_ptr_t &hashTable,
+                        const std::vector<taskscheduler::task_ptr_t> &instances);
+
+  // iterators to the first group of every morsel, typed by the hash table
+  struct AbstractMorselStarts {
+    virtual ~AbstractMorselStarts() {}
+  };
+  template<typename HashTableType>
+  struct MorselStarts : public AbstractMorselStarts {
+    std::vector<typename HashTableType::map_const_iterator_t> starts;
+  };
+  std::shared_ptr<const AbstractMorselStarts> _morselStarts;
 
   std::vector<AggregateFun *> _aggregate_functions;
 
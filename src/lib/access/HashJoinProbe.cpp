@@ -85,6 +85,9 @@ void HashJoinProbe::fetchPositions(storage::pos_list_t *buildTablePosList,
   LOG4CXX_DEBUG(logger, "Hash Table Size:  " << hash_table->size());
 
   for (pos_t probeTableRow = 0; probeTableRow < probeTable->size(); ++probeTableRow) {
+    if (probeTableRow % cancellationCheckInterval == 0) {
+      checkCancellation();
+    }
     pos_list_t matchingRows(hash_table->get(probeTable, _field_definition, probeTableRow));
 
     if (!matchingRows.empty()) {
@@ -11,6 +11,7 @@ class InsertScan : public PlanOperation {
 public:
   virtual ~InsertScan();
   void executePlanOperation();
+  bool isModifying() const { return true; }
   void setInputData(const storage::atable_ptr_t &c);
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
 
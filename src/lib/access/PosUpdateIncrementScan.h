@@ -9,6 +9,7 @@ class PosUpdateIncrementScan : public PlanOperation {
  public:
   PosUpdateIncrementScan(std::string column, Json::Value offset);
   void executePlanOperation();
+  bool isModifying() const { return true; }
   static std::shared_ptr<PlanOperation> parse(Json::Value& data);
  private:
   const std::string _column;
@@ -20,6 +20,8 @@ public:
   virtual ~PosUpdateScan();
 
   void executePlanOperation();
+
+  bool isModifying() const { return true; }
   
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
 
@@ -72,12 +72,12 @@ size_t RadixJoin::getTotalTableSize() {
   return inputTable->size() + inputTable2->size();
 }
 
-double RadixJoin::calcMinMts(double totalTblSizeIn100k) {
-  return min_mts_a() / totalTblSizeIn100k + min_mts_b();
+double RadixJoin::minMtsTerm(double totalTblSizeIn100k) {
+  return 1 / totalTblSizeIn100k;
 }
 
-double RadixJoin::calcA(double totalTblSizeIn100k) {
-  return a_a() * std::pow(totalTblSizeIn100k, 2) + a_b();
+double RadixJoin::aTerm(double totalTblSizeIn100k) {
+  return std::pow(totalTblSizeIn100k, 2);
 }
 
 // FIXME merge logic with RadixJoinTransformation.
@@ -234,6 +234,7 @@ std::vector<taskscheduler::task_ptr_t> RadixJoin::applyDynamicParallelization(si
 void RadixJoin::copyTaskAttributesFromThis(std::shared_ptr<PlanOperation> to){
     to->setPriority(_priority);
     to->setSessionId(_sessionId);
+    to->setQueryId(_queryId);
     to->setPlanId(_planId);
     to->setTXContext(_txContext);
     to->setId(_txContext.tid);
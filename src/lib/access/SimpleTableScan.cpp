@@ -29,16 +29,17 @@ void SimpleTableScan::setupPlanOperation() {
 
 void SimpleTableScan::executePositional() {
   auto tbl = input.getTable(0);
-  storage::pos_list_t *pos_list = new pos_list_t();
-
+  const size_t input_size = tbl->size();
+  storage::PositionListBuilder positions(input_size);
 
   size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size(); row < input_size; ++row) {
-    if ((*_comparator)(row)) {
-      pos_list->push_back(row);
-    }
-  }
-  addResult(storage::PointerCalculator::create(tbl, pos_list));
+  _comparator->matchBatches(row, input_size, [this, &positions] (const pos_t *rows, size_t count) {
+      checkCancellation();
+      for (size_t i = 0; i < count; ++i) {
+        positions.push_back(rows[i]);
+      }
+    });
+  addResult(storage::PointerCalculator::create(tbl, std::move(positions)));
 }
 
 void SimpleTableScan::executeMaterialized() {
@@ -47,19 +48,18 @@ void SimpleTableScan::executeMaterialized() {
   size_t target_row = 0;
 
   size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size();
-       row < input_size;
-       ++row) {
-    if ((*_comparator)(row)) {
-        // TODO materializing result set will make the allocation the boundary
-      result_table->resize(target_row + 1);
-      result_table->copyRowFrom(input.getTable(0),
-                                row,
-                                target_row++,
-                                true /* Copy Value*/,
-                                false /* Use Memcpy */);
-    }
-  }
+  _comparator->matchBatches(row, tbl->size(), [&] (const pos_t *rows, size_t count) {
+      checkCancellation();
+      // TODO materializing result set will make the allocation the boundary
+      result_table->resize(target_row + count);
+      for (size_t i = 0; i < count; ++i) {
+        result_table->copyRowFrom(tbl,
+                                  rows[i],
+                                  target_row++,
+                                  true /* Copy Value*/,
+                                  false /* Use Memcpy */);
+      }
+    });
   addResult(result_table);
 }
 
@@ -14,19 +14,23 @@ namespace access {
 
 template <typename T>
 struct ExtractValue {
-  static inline T extractValue(const storage::c_atable_ptr_t &table,
-                               const size_t &col,
-                               const size_t &row) {
-    return table->getValue<T>(col, row);
+  static inline void extractValues(const storage::c_atable_ptr_t &table,
+                                   const size_t &col,
+                                   const size_t &row,
+                                   const size_t &count,
+                                   T *buffer) {
+    table->getValueRange<T>(col, row, count, buffer);
   }
 };
 
 template <typename T>
 struct ExtractValueId {
-  static inline ValueId extractValue(const storage::c_atable_ptr_t &table,
-                                     const size_t &col,
-                                     const size_t &row) {
-    return table->getValueId(col, row);
+  static inline void extractValues(const storage::c_atable_ptr_t &table,
+                                   const size_t &col,
+                                   const size_t &row,
+                                   const size_t &count,
+                                   ValueId *buffer) {
+    table->getValueIdRange(col, row, count, buffer);
   }
 };
 
@@ -51,10 +55,18 @@ public:
   }
 
   std::vector<pos_t>* sort() const {
+    const size_t size = _t->size();
     std::vector<pair_t> result;
-
-    for (size_t row = 0; row < _t->size(); ++row) {
-      result.push_back({ExtractFunctor<T>::extractValue(_t, _f, row), row});
+    result.reserve(size);
+
+    // The column is read one batch at a time, so only the pairs hold all values
+    std::vector<T> values(std::min(size, storage::AbstractTable::valueBatchSize));
+    for (size_t row = 0; row < size; row += values.size()) {
+      const size_t count = std::min(values.size(), size - row);
+      ExtractFunctor<T>::extractValues(_t, _f, row, count, values.data());
+      for (size_t i = 0; i < count; ++i) {
+        result.push_back({std::move(values[i]), row + i});
+      }
     }
 
     auto asc_sort = [](const pair_t& left, const pair_t& right) { 
@@ -4,6 +4,7 @@
 #include "access/expressions/ExampleExpression.h"
 #include "access/expressions/pred_SimpleExpression.h"
 #include "access/expressions/ExpressionRegistration.h"
+#include "access/expressions/pred_buildExpression.h"
 #include "storage/PointerCalculator.h"
 #include "storage/TableRangeView.h"
 #include "helper/types.h"
@@ -11,8 +12,8 @@
 
 #include "log4cxx/logger.h"
 
-#include "access/UnionAll.h"
-#include "access/system/ResponseTask.h"
+#include "access/UnionScan.h"
+#include "access/system/MorselCursor.h"
 
 namespace hyrise { namespace access {
 
@@ -45,7 +46,16 @@ void TableScan::executePlanOperation() {
 
   // When the input is 0, dont bother trying to generate results
   pos_list_t* positions = nullptr;
-  if(stop - start > 0)
+  if (_morsels) {
+    // morsels arrive in ascending order, so are the positions
+    positions = new pos_list_t();
+    size_t first, last;
+    while (_morsels->next(first, last)) {
+      checkCancellation();
+      std::unique_ptr<pos_list_t> matches(_expr->match(start + first, start + last));
+      positions->insert(positions->end(), matches->begin(), matches->end());
+    }
+  } else if(stop - start > 0)
     positions = _expr->match(start, stop);
   else
     positions = new pos_list_t();
@@ -61,6 +71,10 @@ void TableScan::executePlanOperation() {
 }
 
 std::shared_ptr<PlanOperation> TableScan::parse(const Json::Value& data) {
+  // Predicate trees as used by SimpleTableScan are evaluated batch-wise
+  if (data.isMember("predicates")) {
+    return std::make_shared<TableScan>(expression_uptr_t(buildExpression(data["predicates"])));
+  }
   return std::make_shared<TableScan>(Expressions::parse(data["expression"].asString(), data));
 }
 
@@ -71,90 +85,19 @@ size_t TableScan::getTotalTableSize() {
 }
 
 std::vector<taskscheduler::task_ptr_t> TableScan::applyDynamicParallelization(size_t dynamicCount){
+  return applyMorselParallelization(dynamicCount, getTotalTableSize());
+}
 
-  std::vector<taskscheduler::task_ptr_t> tasks;
-
-  // if no parallelization is necessary, just return this task again as is
-  if (dynamicCount <= 1) {
-    tasks.push_back(shared_from_this());
-    return tasks;
-  }
-
-  std::vector<taskscheduler::task_ptr_t> successors;
-  {
-    std::lock_guard<decltype(_observerMutex)> lk(_observerMutex);
-    // get successors of current task
-    for (auto doneObserver : _doneObservers) {
-      auto const task = std::dynamic_pointer_cast<taskscheduler::Task>(doneObserver.lock());
-      successors.push_back(task);
-    }
-    // remove done observers from current task
-    _doneObservers.clear();
-  }
-
-  // set part and count for this task as first task
-  setPart(0);
-  setCount(dynamicCount);
-  tasks.push_back(std::static_pointer_cast<taskscheduler::Task>(shared_from_this()));
-  std::string opIdBase = _operatorId;
-  _operatorId = opIdBase + "_0";
-
-  // create other TableScans
-  for(size_t i = 1; i < dynamicCount; i++){
-    auto t = std::make_shared<TableScan>(_expr->clone());
-
-    t->setOperatorId(opIdBase + "_" + std::to_string(i));
-
-    // build tabletask
-    t->setProducesPositions(producesPositions);
-    t->setPart(i);
-    t->setCount(dynamicCount);
-    t->setPriority(_priority);
-    t->setSessionId(_sessionId);
-    t->setPlanId(_planId);
-    t->setTXContext(_txContext);
-    t->setId(_txContext.tid);
-    t->setEvent(_papiEvent);
-
-    // set dependencies equal to current task
-    for(auto d : _dependencies)
-      t->addDoneDependency(d);
-
-    t->setPlanOperationName("TableScan");
-    if (auto responseTask = getResponseTask()) {
-      responseTask->registerPlanOperation(t);
-    }
-
-    tasks.push_back(t);
-  }
-
-  // create union and set dependencies
-  auto unionall = std::make_shared<UnionAll>();
-  unionall->setPlanOperationName("UnionAll");
-  unionall->setOperatorId(opIdBase + "_union");
-  unionall->setProducesPositions(producesPositions);
-  unionall->setPriority(_priority);
-  unionall->setSessionId(_sessionId);
-  unionall->setPlanId(_planId);
-  unionall->setTXContext(_txContext);
-  unionall->setId(_txContext.tid);
-  unionall->setEvent(_papiEvent);
-
-
-  for(auto t: tasks)
-    unionall->addDependency(t);
-
-  // set union as dependency to all successors
-  for (auto successor : successors)
-    successor->changeDependency(std::dynamic_pointer_cast<taskscheduler::Task>(shared_from_this()), unionall);
-
-  if (auto responseTask = getResponseTask()) {
-    responseTask->registerPlanOperation(unionall);
-  }
-
-  tasks.push_back(unionall);
+std::shared_ptr<ParallelizablePlanOperation> TableScan::createInstance() {
+  return std::make_shared<TableScan>(_expr->clone());
+}
 
-  return tasks;
+std::shared_ptr<PlanOperation> TableScan::createMerge() {
+  // concatenating would interleave the morsels of the instances,
+  // PointerCalculator::intersect and unite need sorted positions
+  auto unionscan = std::make_shared<UnionScan>();
+  unionscan->setPlanOperationName("UnionScan");
+  return unionscan;
 }
 
 
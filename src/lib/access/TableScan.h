@@ -23,6 +23,9 @@ class TableScan : public ParallelizablePlanOperation {
  protected:
   void setupPlanOperation();
   void executePlanOperation();
+  std::shared_ptr<ParallelizablePlanOperation> createInstance();
+  /// Unites the sorted positions of the instances in row order
+  std::shared_ptr<PlanOperation> createMerge();
 
   // for determineDynamicCount
   virtual size_t getTotalTableSize();
@@ -2,6 +2,8 @@
 #ifndef SRC_LIB_ACCESS_EXPRESSIONS_GENERICEXPRESSIONS_H_
 #define SRC_LIB_ACCESS_EXPRESSIONS_GENERICEXPRESSIONS_H_
 
+#include <algorithm>
+
 #include "json.h"
 
 #include "access/expressions/AbstractExpression.h"
@@ -52,8 +54,52 @@ namespace hyrise { namespace access {
  * generation. Please keep the evaluation order and operator precedence in
  * mind.
  */
- struct GenericExpressionsHelper{
- };
+/*
+ * Selection vectors of the batch-wise evaluation in EXPR_BUILD_LOOP, all
+ * of them hold ascending rows of one batch.
+ */
+struct GenericExpressionsHelper {
+  /// Rows evaluated at once
+  static const size_t batchSize = 1024;
+
+  /// Keeps the rows for which matches(row) holds, returns their number
+  template <typename Fn>
+  static size_t refine(pos_t *rows, const size_t count, Fn matches) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+      rows[kept] = rows[i];
+      kept += matches(rows[i]) ? 1 : 0;
+    }
+    return kept;
+  }
+
+  /// Adds the rows, which are not matched yet, to the matched ones
+  static size_t unite(pos_t *matched, const size_t matched_count, const pos_t *rows, const size_t count) {
+    if (matched_count == 0) {
+      std::copy(rows, rows + count, matched);
+      return count;
+    }
+    pos_t united[batchSize];
+    const auto end = std::merge(matched, matched + matched_count, rows, rows + count, united);
+    std::copy(united, end, matched);
+    return end - united;
+  }
+
+  /// Writes the rows [first, first + count) that are not matched to rows
+  static size_t remaining(const size_t first, const size_t count,
+                          const pos_t *matched, const size_t matched_count, pos_t *rows) {
+    size_t kept = 0;
+    size_t j = 0;
+    for (size_t row = first; row < first + count; ++row) {
+      if (j < matched_count && matched[j] == row) {
+        ++j;
+      } else {
+        rows[kept++] = row;
+      }
+    }
+    return kept;
+  }
+};
 
 #define STORE_TWO_FIELD_SEQ_FLD1_LTE_FLOAT (f1)(hyrise_float_t)(<=)(asFloat)
 #define STORE_TWO_FIELD_SEQ_FLD1_LTE_INT (f1)(hyrise_int_t)(<=)(asInt)
@@ -51,6 +51,10 @@ class BetweenExpression : public SimpleFieldExpression {
 
   virtual ~BetweenExpression() {}
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    return make_unique<BetweenExpression<T>>(*this);
+  }
+
   inline virtual bool operator()(size_t row) {
     ValueId valueId = table->getValueId(field, row);
 
@@ -71,6 +75,25 @@ class BetweenExpression : public SimpleFieldExpression {
     T value = table->getValue<T>(field, row);
     return (value <= upper_value) && (value >= lower_value);
   }
+
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    ValueId valueIds[batchSize];
+    table->getValueIdsAt(field, rows, count, valueIds);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const ValueId& valueId = valueIds[i];
+      bool result;
+      if ((valueId.table == lower_bound.table) && (valueId.table == upper_bound.table)) {
+        result = (valueId.valueId <= upper_bound.valueId) && (valueId.valueId >= lower_bound.valueId);
+      } else {
+        T value = table->getValue<T>(field, rows[i]);
+        result = (value <= upper_value) && (value >= lower_value);
+      }
+      rows[matched] = rows[i];
+      matched += result ? 1 : 0;
+    }
+    return matched;
+  }
 };
 
 } } // namespace hyrise::access
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <algorithm>
+
 #include "pred_common.h"
 
 namespace hyrise {
@@ -35,6 +37,15 @@ class CompoundExpression : public SimpleExpression {
     }
   }
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    auto result = make_unique<CompoundExpression>(type);
+    result->lhs = cloneChild(lhs);
+    if (!one_leg) {
+      result->rhs = cloneChild(rhs);
+    }
+    return std::move(result);
+  }
+
   virtual void walk(const std::vector<storage::c_atable_ptr_t > &l) {
     lhs->walk(l);
 
@@ -63,6 +74,42 @@ class CompoundExpression : public SimpleExpression {
     }
   }
 
+  // AND refines the selection of lhs further, OR only evaluates rhs on the
+  // rows lhs rejected and NOT keeps the rows lhs rejected
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    switch (type) {
+      case AND: {
+        const size_t matched = lhs->refine(rows, count);
+        return (matched == 0) ? 0 : rhs->refine(rows, matched);
+      }
+
+      case OR: {
+        pos_t left[batchSize];
+        std::copy(rows, rows + count, left);
+        const size_t left_count = lhs->refine(left, count);
+        if (left_count == count) {
+          return count;
+        }
+
+        pos_t right[batchSize];
+        const size_t rest = difference(rows, count, left, left_count, right);
+        const size_t right_count = rhs->refine(right, rest);
+        return std::merge(left, left + left_count, right, right + right_count, rows) - rows;
+      }
+
+      case NOT: {
+        pos_t matched[batchSize];
+        std::copy(rows, rows + count, matched);
+        const size_t matched_count = lhs->refine(matched, count);
+        return difference(rows, count, matched, matched_count, rows);
+      }
+
+      default:
+        throw std::runtime_error("Unknown Expression Type");
+        break;
+    }
+  }
+
   inline void add(SimpleExpression *e) {
     if (!lhs) lhs = e;
     else if (!rhs) rhs = e;
@@ -72,6 +119,28 @@ class CompoundExpression : public SimpleExpression {
   inline bool isSetup() {
     return ((one_leg) && (lhs != nullptr)) || ((rhs != nullptr) && (lhs != nullptr));
   }
+
+ private:
+  static SimpleExpression *cloneChild(SimpleExpression *e) {
+    return static_cast<SimpleExpression *>(e->clone().release());
+  }
+
+  // Writes the rows of rows[0, count) that are not in the sorted subset
+  // to result and returns their number, result may be rows itself
+  static size_t difference(const pos_t *rows, const size_t count,
+                           const pos_t *subset, const size_t subset_count,
+                           pos_t *result) {
+    size_t kept = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (j < subset_count && subset[j] == rows[i]) {
+        ++j;
+      } else {
+        result[kept++] = rows[i];
+      }
+    }
+    return kept;
+  }
 };
 
 } } // namespace hyrise::access
@@ -54,6 +54,21 @@ class EqualsExpression : public SimpleFieldExpression {
   inline virtual bool operator()(size_t row) {
     return value_exists && table->getValueId(field, row) == lower_bound;
   }
+
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    if (!value_exists) {
+      return 0;
+    }
+
+    ValueId valueIds[batchSize];
+    table->getValueIdsAt(field, rows, count, valueIds);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      rows[matched] = rows[i];
+      matched += (valueIds[i] == lower_bound) ? 1 : 0;
+    }
+    return matched;
+  }
 };
 
 
@@ -0,0 +1,114 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "pred_FusedConjunction.h"
+
+#include <json.h>
+
+#include "expression_types.h"
+#include "../json_converters.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+const size_t maxFusedPredicates = 4;
+
+template <typename T, template <typename> class Op>
+std::unique_ptr<FusedPredicate> createKernel(const Json::Value &predicate) {
+  const T value = json_converter::convert<T>(predicate["value"]);
+  if (predicate["f"].isString()) {
+    return make_unique<FusedPredicateKernel<T, Op<T>>>(predicate["f"].asString(), value);
+  }
+  return make_unique<FusedPredicateKernel<T, Op<T>>>(predicate["f"].asUInt(), value);
+}
+
+template <typename T>
+std::unique_ptr<FusedPredicate> createKernel(PredicateType::type pred_type, const Json::Value &predicate) {
+  switch (pred_type) {
+    case PredicateType::EqualsExpression:
+    case PredicateType::EqualsExpressionValue:
+      return createKernel<T, std::equal_to>(predicate);
+    case PredicateType::LessThanExpression:
+    case PredicateType::LessThanExpressionValue:
+      return createKernel<T, std::less>(predicate);
+    case PredicateType::GreaterThanExpression:
+    case PredicateType::GreaterThanExpressionValue:
+      return createKernel<T, std::greater>(predicate);
+    case PredicateType::LessThanEqualsExpressionValue:
+      return createKernel<T, std::less_equal>(predicate);
+    case PredicateType::GreaterThanEqualsExpressionValue:
+      return createKernel<T, std::greater_equal>(predicate);
+    default:
+      return nullptr;
+  }
+}
+
+// Returns nullptr for predicates without a kernel
+std::unique_ptr<FusedPredicate> createKernel(PredicateType::type pred_type, const Json::Value &predicate) {
+  if (!predicate["f"].isNumeric() && !predicate["f"].isString()) {
+    return nullptr;
+  }
+
+  switch (predicate["vtype"].asUInt()) {
+    case IntegerType:
+      return createKernel<hyrise_int_t>(pred_type, predicate);
+    case FloatType:
+      return createKernel<hyrise_float_t>(pred_type, predicate);
+    case StringType:
+      return createKernel<hyrise_string_t>(pred_type, predicate);
+    default:
+      return nullptr;
+  }
+}
+
+template <size_t N>
+SimpleExpression *createConjunction(size_t input, std::vector<std::unique_ptr<FusedPredicate>> &kernels) {
+  typename FusedConjunction<N>::predicates_t predicates;
+  std::move(kernels.begin(), kernels.end(), predicates.begin());
+  return new FusedConjunction<N>(input, std::move(predicates));
+}
+
+}  // namespace
+
+SimpleExpression *buildFusedConjunction(const Json::Value &predicates) {
+  std::vector<std::unique_ptr<FusedPredicate>> kernels;
+  size_t input = 0;
+
+  // Number of operands still expected by the prefix notation
+  size_t open = 1;
+  for (unsigned i = 0; i < predicates.size(); ++i) {
+    const Json::Value &predicate = predicates[i];
+    if (open == 0) {
+      return nullptr;
+    }
+
+    const PredicateType::type pred_type = parsePredicateType(predicate["type"]);
+    if (pred_type == PredicateType::AND) {
+      ++open;
+      continue;
+    }
+
+    auto kernel = createKernel(pred_type, predicate);
+    if (!kernel || kernels.size() == maxFusedPredicates ||
+        (!kernels.empty() && predicate["in"].asUInt() != input)) {
+      return nullptr;
+    }
+    input = predicate["in"].asUInt();
+    kernels.push_back(std::move(kernel));
+    --open;
+  }
+
+  if (open != 0) {
+    return nullptr;
+  }
+
+  switch (kernels.size()) {
+    case 1: return createConjunction<1>(input, kernels);
+    case 2: return createConjunction<2>(input, kernels);
+    case 3: return createConjunction<3>(input, kernels);
+    case 4: return createConjunction<4>(input, kernels);
+    default: return nullptr;
+  }
+}
+
+} } // namespace hyrise::access
@@ -0,0 +1,178 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <type_traits>
+
+#include "pred_common.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * One simple predicate "field op value" of a FusedConjunction.
+ * Evaluation works on selection vectors like SimpleExpression::refine,
+ * the virtual call happens once per batch instead of once per row.
+ */
+class FusedPredicate {
+ public:
+  virtual ~FusedPredicate() {}
+  virtual void walk(const storage::c_atable_ptr_t &table) = 0;
+  virtual size_t refine(const storage::c_atable_ptr_t &table, pos_t *rows, size_t count) const = 0;
+  virtual std::unique_ptr<FusedPredicate> clone() const = 0;
+  // Equality predicates are the most selective and evaluated first
+  virtual bool isEquality() const = 0;
+};
+
+/*
+ * Scan kernel for a comparison Op (std::equal_to, std::less, ...) on a
+ * column of type T. For an order preserving main dictionary, walk
+ * translates the comparison into a range of value-IDs, so rows of the
+ * main are matched by comparing their value-ID only. Rows of other
+ * tables, e.g. the delta, compare the actual value.
+ */
+template <typename T, typename Op>
+class FusedPredicateKernel : public FusedPredicate {
+ private:
+  field_t _field;
+  field_name_t _field_name;
+  T _value;
+  Op _operator;
+
+  bool _ordered = false;
+  // Matching value-IDs of the main are those with
+  // (valueId - _lower < _width) == _inside
+  value_id_t _lower = 0;
+  value_id_t _width = 0;
+  bool _inside = true;
+
+ public:
+  FusedPredicateKernel(field_t field, T value) : _field(field), _value(value) {}
+
+  FusedPredicateKernel(field_name_t field_name, T value) : _field(0), _field_name(field_name), _value(value) {}
+
+  virtual void walk(const storage::c_atable_ptr_t &table) {
+    if (_field_name.size() > 0) {
+      _field = table->numberOfColumn(_field_name);
+    }
+
+    auto dict = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(table->dictionaryAt(_field));
+    _ordered = dict && dict->isOrdered();
+    if (_ordered) {
+      // [first, behind) are the value-IDs of values equal to _value
+      setRange(_operator, dict->getValueIdForValue(_value), dict->getValueIdForValueGreater(_value));
+    }
+  }
+
+  virtual size_t refine(const storage::c_atable_ptr_t &table, pos_t *rows, const size_t count) const {
+    size_t matched = 0;
+    if (!_ordered) {
+      T values[SimpleExpression::batchSize];
+      table->template getValuesAt<T>(_field, rows, count, values);
+      for (size_t i = 0; i < count; ++i) {
+        rows[matched] = rows[i];
+        matched += _operator(values[i], _value) ? 1 : 0;
+      }
+      return matched;
+    }
+
+    ValueId valueIds[SimpleExpression::batchSize];
+    table->getValueIdsAt(_field, rows, count, valueIds);
+    for (size_t i = 0; i < count; ++i) {
+      const bool result = (valueIds[i].table == 0) ?
+          ((static_cast<value_id_t>(valueIds[i].valueId - _lower) < _width) == _inside) :
+          _operator(table->template getValue<T>(_field, rows[i]), _value);
+      rows[matched] = rows[i];
+      matched += result ? 1 : 0;
+    }
+    return matched;
+  }
+
+  virtual std::unique_ptr<FusedPredicate> clone() const {
+    return make_unique<FusedPredicateKernel<T, Op>>(*this);
+  }
+
+  virtual bool isEquality() const {
+    return std::is_same<Op, std::equal_to<T>>::value;
+  }
+
+ private:
+  void setRange(const value_id_t lower, const value_id_t upper, const bool inside) {
+    _lower = lower;
+    _width = upper - lower;
+    _inside = inside;
+  }
+
+  void setRange(const std::equal_to<T>&, value_id_t first, value_id_t behind) { setRange(first, behind, true); }
+  void setRange(const std::not_equal_to<T>&, value_id_t first, value_id_t behind) { setRange(first, behind, false); }
+  void setRange(const std::less<T>&, value_id_t first, value_id_t behind) { setRange(0, first, true); }
+  void setRange(const std::less_equal<T>&, value_id_t first, value_id_t behind) { setRange(0, behind, true); }
+  void setRange(const std::greater<T>&, value_id_t first, value_id_t behind) { setRange(0, behind, false); }
+  void setRange(const std::greater_equal<T>&, value_id_t first, value_id_t behind) { setRange(0, first, false); }
+};
+
+/*
+ * Conjunction of N simple predicates on the same input, evaluated by
+ * refining one selection vector with the kernel of every predicate in
+ * turn. buildExpression creates it for predicate trees consisting of AND
+ * nodes and up to four comparisons, see buildFusedConjunction.
+ */
+template <size_t N>
+class FusedConjunction : public SimpleExpression {
+ public:
+  typedef std::array<std::unique_ptr<FusedPredicate>, N> predicates_t;
+
+ private:
+  size_t _input;
+  storage::c_atable_ptr_t _table;
+  predicates_t _predicates;
+
+ public:
+  FusedConjunction(size_t input, predicates_t predicates) : _input(input), _predicates(std::move(predicates)) {
+    std::stable_partition(_predicates.begin(), _predicates.end(),
+                          [] (const std::unique_ptr<FusedPredicate>& p) { return p->isEquality(); });
+  }
+
+  virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) {
+    if (!_table) {
+      _table = l.at(_input);
+    }
+
+    for (const auto& predicate : _predicates) {
+      predicate->walk(_table);
+    }
+  }
+
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    size_t matched = count;
+    for (size_t i = 0; i < N && matched > 0; ++i) {
+      matched = _predicates[i]->refine(_table, rows, matched);
+    }
+    return matched;
+  }
+
+  inline virtual bool operator()(size_t row) {
+    pos_t selection = row;
+    return refine(&selection, 1) == 1;
+  }
+
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    predicates_t predicates;
+    for (size_t i = 0; i < N; ++i) {
+      predicates[i] = _predicates[i]->clone();
+    }
+    return make_unique<FusedConjunction<N>>(_input, std::move(predicates));
+  }
+};
+
+/*
+ * Returns a FusedConjunction for predicates (in the prefix notation of
+ * buildExpression) that only consist of AND nodes and up to four
+ * comparisons of int, float or string fields of the same input, or
+ * nullptr for all other predicate trees.
+ */
+SimpleExpression *buildFusedConjunction(const Json::Value &predicates);
+
+} } // namespace hyrise::access
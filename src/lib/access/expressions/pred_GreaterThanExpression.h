@@ -29,6 +29,10 @@ class GreaterThanExpression : public SimpleFieldExpression {
 
   virtual ~GreaterThanExpression() { }
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    return make_unique<GreaterThanExpression<T>>(*this);
+  }
+
   virtual void walk(const std::vector<storage::c_atable_ptr_t > &l) {
     SimpleFieldExpression::walk(l);
 
@@ -58,6 +62,26 @@ class GreaterThanExpression : public SimpleFieldExpression {
 
     return table->getValue<T>(field, row) > value;
   }
+
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    ValueId valueIds[batchSize];
+    table->getValueIdsAt(field, rows, count, valueIds);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const ValueId& valueId = valueIds[i];
+      bool result;
+      // value-IDs of the delta are not ordered and need the actual value
+      if (valueId.table == lower_bound.table &&
+          (valueId.valueId != lower_bound.valueId || value_exists)) {
+        result = valueId.valueId > lower_bound.valueId;
+      } else {
+        result = table->getValue<T>(field, rows[i]) > value;
+      }
+      rows[matched] = rows[i];
+      matched += result ? 1 : 0;
+    }
+    return matched;
+  }
 };
 
 
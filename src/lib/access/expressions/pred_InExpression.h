@@ -39,6 +39,10 @@ public:
     values(getValues(value))
   {}
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    return make_unique<InExpression<T>>(*this);
+  }
+
   ///
   /// @return true if the value at column[field,row] matches any values of the list named "values"
   ///
@@ -47,6 +51,18 @@ public:
     return std::find(values.cbegin(), values.cend(), currentValue) != values.cend();
   }
 
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    T currentValues[batchSize];
+    table->template getValuesAt<T>(field, rows, count, currentValues);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (std::find(values.cbegin(), values.cend(), currentValues[i]) != values.cend()) {
+        rows[matched++] = rows[i];
+      }
+    }
+    return matched;
+  }
+
 private:
   const std::vector<T> values;
   ///
@@ -39,6 +39,10 @@ class LessThanExpression : public SimpleFieldExpression {
 
   virtual ~LessThanExpression() { }
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    return make_unique<LessThanExpression<T>>(*this);
+  }
+
   inline virtual bool operator()(size_t row) {
     ValueId valueId = table->getValueId(field, row);
     if (valueId.valueId < lower_bound.valueId) {
@@ -46,6 +50,17 @@ class LessThanExpression : public SimpleFieldExpression {
     } else
       return false;
   }
+
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    ValueId valueIds[batchSize];
+    table->getValueIdsAt(field, rows, count, valueIds);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      rows[matched] = rows[i];
+      matched += (valueIds[i].valueId < lower_bound.valueId) ? 1 : 0;
+    }
+    return matched;
+  }
 };
 
 
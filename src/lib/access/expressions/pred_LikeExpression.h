@@ -37,6 +37,10 @@ public:
     regExpr(boost::regex(value))
   { }
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    return make_unique<LikeExpression>(*this);
+  }
+
   ///
   /// Applies the like expression on each field using the generated regex object.
   /// @return true if current line matches the regular expression.
@@ -47,6 +51,18 @@ public:
     return boost::regex_match(currentValue, regExpr);
   }
 
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    hyrise_string_t values[batchSize];
+    table->getValuesAt<hyrise_string_t>(field, rows, count, values);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (boost::regex_match(values[i], regExpr)) {
+        rows[matched++] = rows[i];
+      }
+    }
+    return matched;
+  }
+
 private:
   /// Hold the regular expression object. Generated in constructor.
   const boost::regex regExpr;
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <algorithm>
+
 #include "storage/storage_types.h"
 #include "helper/types.h"
 #include "access/expressions/AbstractExpression.h"
@@ -10,16 +12,53 @@ namespace access {
 
 class SimpleExpression : public access::AbstractExpression {
  public:
+  /// Maximum number of rows passed to refine at once
+  static const size_t batchSize = 1024;
+
   virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) = 0;
 
   virtual pos_list_t* match(const size_t start, const size_t stop) {
     auto pl = new pos_list_t;
-    for(size_t row=0; row < stop; ++row) {
-      if (operator()(row)) {
-        pl->push_back(row);
+    matchBatches(start, stop, [pl] (const pos_t *rows, size_t count) {
+        pl->insert(pl->end(), rows, rows + count);
+      });
+    return pl;
+  }
+
+  /*
+   * Evaluates the rows [start, stop) in batches of batchSize rows and
+   * calls fn(rows, count) with the ascending matching rows of each batch.
+   */
+  template <typename Fn>
+  void matchBatches(const size_t start, const size_t stop, Fn fn) {
+    pos_t rows[batchSize];
+    for (size_t first = start; first < stop; first += batchSize) {
+      const size_t count = std::min(batchSize, stop - first);
+      for (size_t i = 0; i < count; ++i) {
+        rows[i] = first + i;
+      }
+      const size_t matched = refine(rows, count);
+      if (matched > 0) {
+        fn(rows, matched);
       }
     }
-    return pl;
+  }
+
+  /*
+   * Refines the selection vector rows[0, count), which is sorted
+   * ascending and holds at most batchSize rows, to the rows matching this
+   * expression and returns their number. The order of the rows is kept.
+   * The default evaluates operator() per row, derived expressions read
+   * the whole selection at once.
+   */
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (operator()(rows[i])) {
+        rows[matched++] = rows[i];
+      }
+    }
+    return matched;
   }
 
   inline virtual bool operator()(size_t row) {
@@ -28,4 +67,3 @@ class SimpleExpression : public access::AbstractExpression {
 };
 
 } } // namespace hyrise::access
-
@@ -72,9 +72,24 @@ class GenericExpressionValue : public SimpleFieldExpression {
 
   virtual ~GenericExpressionValue() { }
 
+  virtual std::unique_ptr<AbstractExpression> clone() {
+    return make_unique<GenericExpressionValue<T, Op>>(*this);
+  }
+
   inline virtual bool operator()(size_t row) {
     return _operator(table->template getValue<T>(field, row), value);
   }
+
+  virtual size_t refine(pos_t *rows, const size_t count) {
+    T values[batchSize];
+    table->template getValuesAt<T>(field, rows, count, values);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      rows[matched] = rows[i];
+      matched += _operator(values[i], value) ? 1 : 0;
+    }
+    return matched;
+  }
 };
 
 } } // namespace hyrise::access
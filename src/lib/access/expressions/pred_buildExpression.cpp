@@ -7,11 +7,14 @@
 #include "../json_converters.h"
 #include "predicates.h"
 #include "pred_expression_factory.h"
+#include "pred_FusedConjunction.h"
 #include "storage/meta_storage.h"
 
 namespace hyrise {
 namespace access {
 
+const size_t SimpleExpression::batchSize;
+
 SimpleFieldExpression *buildFieldExpression(PredicateType::type pred_type, const Json::Value &predicate) {
   storage::type_switch<hyrise_basic_types> ts;
   expression_factory fun;
@@ -24,6 +27,11 @@ SimpleFieldExpression *buildFieldExpression(PredicateType::type pred_type, const
 };
 
 SimpleExpression *buildExpression(const Json::Value &predicates) {
+  // Conjunctions of simple comparisons use a specialized scan kernel
+  if (auto fused = buildFusedConjunction(predicates)) {
+    return fused;
+  }
+
   PredicateBuilder b;
 
   Json::Value predicate;
@@ -6,6 +6,7 @@
 #include <stdio.h>
 
 #include "helper/types.h"
+#include "helper/make_unique.h"
 
 #include <storage/storage_types.h>
 #include <storage/AbstractTable.h>
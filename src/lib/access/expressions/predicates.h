@@ -4,6 +4,7 @@
 #include "pred_BetweenOperation.h"
 #include "pred_CompoundExpression.h"
 #include "pred_EqualsExpression.h"
+#include "pred_FusedConjunction.h"
 #include "pred_GreaterThanExpression.h"
 #include "pred_LessThanExpression.h"
 #include "pred_PredicateBuilder.h"
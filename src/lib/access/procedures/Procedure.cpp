@@ -0,0 +1,182 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/procedures/Procedure.h"
+
+#include <cstdlib>
+
+#include <log4cxx/logger.h>
+
+#include "helper/HttpHelper.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.access.procedures"));
+
+bool isJsonRequest(const net::AbstractConnection &connection) {
+  return connection.getHeader("Content-Type").compare(0, 16, "application/json") == 0;
+}
+
+ProcedureException decodeError(const std::string &name, const std::string &type) {
+  return ProcedureException("Parameter " + name + " is no " + type);
+}
+}
+
+ProcedureParameters ProcedureParameters::fromRequest(const net::AbstractConnection &connection) {
+  Json::Value values(Json::objectValue);
+  if (isJsonRequest(connection)) {
+    Json::Reader reader;
+    if (!reader.parse(connection.getBody(), values, false)) {
+      throw ProcedureException(reader.getFormatedErrorMessages());
+    }
+    if (!values.isObject()) {
+      throw ProcedureException("Request body is no JSON object");
+    }
+  } else {
+    for (const auto& kv : parseHTTPFormData(connection.getBody())) {
+      values[kv.first] = urldecode(kv.second);
+    }
+  }
+  return ProcedureParameters(std::move(values));
+}
+
+const Json::Value &ProcedureParameters::at(const std::string &name) const {
+  if (!has(name)) {
+    throw ProcedureException("Missing parameter " + name);
+  }
+  return _values[name];
+}
+
+template <>
+hyrise_int_t ProcedureParameters::decode<hyrise_int_t>(const std::string &name, const Json::Value &value) {
+  if (value.isIntegral()) {
+    return value.asInt64();
+  }
+  if (value.isString()) {
+    const std::string str = value.asString();
+    char *end = nullptr;
+    const hyrise_int_t result = std::strtoll(str.c_str(), &end, 10);
+    if (!str.empty() && *end == '\0') {
+      return result;
+    }
+  }
+  throw decodeError(name, "integer");
+}
+
+template <>
+hyrise_float_t ProcedureParameters::decode<hyrise_float_t>(const std::string &name, const Json::Value &value) {
+  if (value.isNumeric()) {
+    return value.asDouble();
+  }
+  if (value.isString()) {
+    const std::string str = value.asString();
+    char *end = nullptr;
+    const hyrise_float_t result = std::strtod(str.c_str(), &end);
+    if (!str.empty() && *end == '\0') {
+      return result;
+    }
+  }
+  throw decodeError(name, "float");
+}
+
+template <>
+std::string ProcedureParameters::decode<std::string>(const std::string &name, const Json::Value &value) {
+  if (!value.isConvertibleTo(Json::stringValue) || value.isNull()) {
+    throw decodeError(name, "string");
+  }
+  return value.asString();
+}
+
+template <>
+bool ProcedureParameters::decode<bool>(const std::string &name, const Json::Value &value) {
+  if (value.isBool()) {
+    return value.asBool();
+  }
+  if (value.isString()) {
+    if (value.asString() == "true" || value.asString() == "1") {
+      return true;
+    }
+    if (value.asString() == "false" || value.asString() == "0") {
+      return false;
+    }
+  }
+  throw decodeError(name, "boolean");
+}
+
+storage::store_ptr_t ProcedureContext::getStore(const std::string &name) const {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::StorageManager::getInstance()->getTable(name));
+  if (!store) {
+    throw ProcedureException("Table " + name + " is no store");
+  }
+  return store;
+}
+
+std::shared_ptr<storage::AbstractIndex> ProcedureContext::getIndex(const std::string &name) const {
+  return io::StorageManager::getInstance()->getInvertedIndex(name);
+}
+
+bool ProcedureContext::isVisible(const storage::store_ptr_t &store, pos_t pos) const {
+  return store->isVisibleForTransaction(pos, _txContext.lastCid, _txContext.tid);
+}
+
+pos_t ProcedureContext::insert(const storage::store_ptr_t &store, const std::vector<Json::Value> &row) {
+  if (row.size() != store->columnCount()) {
+    throw ProcedureException("Row has " + std::to_string(row.size()) + " values, table has " +
+                             std::to_string(store->columnCount()) + " columns");
+  }
+  const auto writeArea = store->appendToDelta(1);
+  store->copyRowToDeltaFromJSONVector(row, writeArea.first, _txContext.tid);
+
+  const pos_t pos = store->getMainTable()->size() + writeArea.first;
+  tx::TransactionManager::getInstance()[_txContext.tid].insertPos(store, pos);
+  ++_affectedRows;
+  return pos;
+}
+
+void ProcedureContext::remove(const storage::store_ptr_t &store, pos_t pos) {
+  if (store->markForDeletion(pos, _txContext.tid) != tx::TX_CODE::TX_OK) {
+    throw ProcedureException("Aborted TX because TID of other TX found");
+  }
+  tx::TransactionManager::getInstance()[_txContext.tid].deletePos(store, pos);
+  ++_affectedRows;
+}
+
+pos_t ProcedureContext::update(const storage::store_ptr_t &store, pos_t pos, const std::vector<Json::Value> &row) {
+  remove(store, pos);
+  --_affectedRows;
+  return insert(store, row);
+}
+
+Json::Value Procedure::call(const ProcedureParameters &parameters) {
+  Json::Value response;
+  // Procedures read under MVCC, see ProcedureContext::isVisible
+  auto txContext = tx::TransactionManager::beginTransaction(true);
+  try {
+    ProcedureContext context(txContext);
+    response["result"] = execute(context, parameters);
+    tx::TransactionManager::commitTransaction(txContext);
+    response["affectedRows"] = Json::Value::UInt64(context.getAffectedRows());
+  } catch (const std::exception &e) {
+    tx::TransactionManager::rollbackTransaction(txContext);
+    LOG4CXX_DEBUG(_logger, vname() << " failed: " << e.what());
+    response.removeMember("result");
+    response["error"].append(Json::Value(e.what()));
+  }
+  return response;
+}
+
+void Procedure::operator()() {
+  Json::Value response;
+  try {
+    response = call(ProcedureParameters::fromRequest(*_connection));
+  } catch (const ProcedureException &e) {
+    response["error"].append(Json::Value(e.what()));
+  }
+  Json::FastWriter fw;
+  _connection->respond(fw.write(response));
+}
+
+} } // namespace hyrise::access
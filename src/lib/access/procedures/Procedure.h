@@ -0,0 +1,161 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_PROCEDURES_PROCEDURE_H_
+#define SRC_LIB_ACCESS_PROCEDURES_PROCEDURE_H_
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <json.h>
+
+#include "helper/types.h"
+#include "io/TXContext.h"
+#include "net/Router.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+
+namespace storage {
+class AbstractIndex;
+}
+
+namespace access {
+
+/// For all errors of a stored procedure, the transaction is rolled back
+class ProcedureException : public std::runtime_error {
+ public:
+  explicit ProcedureException(const std::string &what) : std::runtime_error(what) {}
+};
+
+/*
+ * Parameters of a procedure call, read from a form encoded request body
+ * or from the fields of a JSON object for application/json requests.
+ * get<T> decodes a parameter as hyrise_int_t, hyrise_float_t,
+ * std::string or bool and throws a ProcedureException if it is missing
+ * or cannot be decoded.
+ */
+class ProcedureParameters {
+ public:
+  ProcedureParameters() : _values(Json::objectValue) {}
+  explicit ProcedureParameters(Json::Value values) : _values(std::move(values)) {}
+
+  static ProcedureParameters fromRequest(const net::AbstractConnection &connection);
+
+  bool has(const std::string &name) const { return _values.isMember(name); }
+
+  template <typename T>
+  T get(const std::string &name) const {
+    return decode<T>(name, at(name));
+  }
+
+  template <typename T>
+  T get(const std::string &name, const T &defaultValue) const {
+    return has(name) ? get<T>(name) : defaultValue;
+  }
+
+  /// Raw value, e.g. for arrays of order lines in JSON requests
+  const Json::Value &at(const std::string &name) const;
+
+ private:
+  template <typename T>
+  static T decode(const std::string &name, const Json::Value &value);
+
+  Json::Value _values;
+};
+
+template <> hyrise_int_t ProcedureParameters::decode<hyrise_int_t>(const std::string &name, const Json::Value &value);
+template <> hyrise_float_t ProcedureParameters::decode<hyrise_float_t>(const std::string &name, const Json::Value &value);
+template <> std::string ProcedureParameters::decode<std::string>(const std::string &name, const Json::Value &value);
+template <> bool ProcedureParameters::decode<bool>(const std::string &name, const Json::Value &value);
+
+/*
+ * Transaction of a procedure call with direct access to tables, indexes
+ * and the write primitives of Store. Writes are recorded in the
+ * modifications of the transaction, exactly like InsertScan and Delete
+ * do, so they become visible on commit and are undone on rollback.
+ */
+class ProcedureContext {
+ public:
+  explicit ProcedureContext(tx::TXContext txContext) : _txContext(txContext) {}
+
+  const tx::TXContext &getTXContext() const { return _txContext; }
+
+  /// Table `name` from the StorageManager, throws if it is no Store
+  storage::store_ptr_t getStore(const std::string &name) const;
+
+  std::shared_ptr<storage::AbstractIndex> getIndex(const std::string &name) const;
+
+  template <typename IndexType>
+  std::shared_ptr<IndexType> getIndex(const std::string &name) const {
+    auto index = std::dynamic_pointer_cast<IndexType>(getIndex(name));
+    if (!index) {
+      throw ProcedureException("Index " + name + " has not the requested type");
+    }
+    return index;
+  }
+
+  /// Whether row `pos` of `store` is visible to this transaction
+  bool isVisible(const storage::store_ptr_t &store, pos_t pos) const;
+
+  /// Appends `row` to the delta of `store`, returns its position
+  pos_t insert(const storage::store_ptr_t &store, const std::vector<Json::Value> &row);
+
+  /// Deletes row `pos`, throws a ProcedureException if another
+  /// transaction modifies it concurrently
+  void remove(const storage::store_ptr_t &store, pos_t pos);
+
+  /// Replaces row `pos` by `row` and returns the new position
+  pos_t update(const storage::store_ptr_t &store, pos_t pos, const std::vector<Json::Value> &row);
+
+  size_t getAffectedRows() const { return _affectedRows; }
+
+ private:
+  tx::TXContext _txContext;
+  size_t _affectedRows = 0;
+};
+
+/*
+ * Base class of compiled stored procedures. A procedure runs its
+ * transaction in the request handler task itself, without building,
+ * parsing or scheduling a plan:
+ *
+ *   class NewOrder : public Procedure {
+ *    public:
+ *     explicit NewOrder(net::AbstractConnection *connection) : Procedure(connection) {}
+ *     static std::string name() { return "NewOrder"; }
+ *     const std::string vname() { return "NewOrder"; }
+ *    protected:
+ *     Json::Value execute(ProcedureContext &context, const ProcedureParameters &parameters);
+ *   };
+ *
+ *   bool NewOrder::registered = Procedure::registerProcedure<NewOrder>("neworder");
+ *
+ * registers the procedure for "/proc/neworder/". The transaction is
+ * committed when execute returns and rolled back when it throws. The
+ * response holds the returned value in "result" and the number of
+ * written rows in "affectedRows", or the message in "error".
+ */
+class Procedure : public net::AbstractRequestHandler {
+ public:
+  explicit Procedure(net::AbstractConnection *connection) : _connection(connection) {}
+
+  void operator()();
+
+  template <typename ProcedureClass>
+  static bool registerProcedure(const std::string &name) {
+    return net::Router::registerRoute<ProcedureClass>("/proc/" + name + "/");
+  }
+
+  /// Runs the procedure outside of a request and returns its response
+  Json::Value call(const ProcedureParameters &parameters);
+
+ protected:
+  virtual Json::Value execute(ProcedureContext &context, const ProcedureParameters &parameters) = 0;
+
+  net::AbstractConnection *_connection;
+};
+
+} } // namespace hyrise::access
+
+#endif  // SRC_LIB_ACCESS_PROCEDURES_PROCEDURE_H_
@@ -0,0 +1,194 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/AdmissionControl.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "log4cxx/logger.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.access"));
+}
+
+AdmissionTicket::AdmissionTicket(AdmissionControl &control, int priority, int sessionId, size_t tasks)
+    : _control(control), _priority(priority), _sessionId(sessionId), _tasks(tasks) {}
+
+AdmissionTicket::~AdmissionTicket() {
+  _control.release(_priority, _sessionId, _tasks);
+}
+
+AdmissionControl &AdmissionControl::getInstance() {
+  static AdmissionControl control;
+  return control;
+}
+
+AdmissionControl::~AdmissionControl() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _expireCondition.notify_all();
+  if (_expireThread.joinable()) {
+    _expireThread.join();
+  }
+}
+
+void AdmissionControl::setLimits(const AdmissionLimits &limits) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _limits = limits;
+}
+
+AdmissionLimits AdmissionControl::getLimits() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _limits;
+}
+
+size_t AdmissionControl::running() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _running;
+}
+
+size_t AdmissionControl::waiting() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _waiting.size();
+}
+
+void AdmissionControl::admit(int priority, int sessionId, size_t tasks,
+                             admitted_fn_t admitted, rejected_fn_t rejected) {
+  Query query {priority, sessionId, tasks, clock_t::time_point(), std::move(admitted), std::move(rejected)};
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!waitingAhead(query) && fits(query)) {
+      acquire(query);
+      lock.unlock();
+      query.admitted(std::unique_ptr<AdmissionTicket>(new AdmissionTicket(*this, priority, sessionId, tasks)));
+      return;
+    }
+
+    if (_waiting.size() < _limits.queueLength) {
+      query.deadline = clock_t::now() + _limits.timeout;
+      _waiting.push_back(std::move(query));
+      if (!_expireThread.joinable()) {
+        _expireThread = std::thread(&AdmissionControl::expireWaiting, this);
+      }
+      _expireCondition.notify_all();
+      return;
+    }
+  }
+
+  LOG4CXX_WARN(_logger, "Admission queue full, rejecting query");
+  query.rejected("AdmissionControl: too many queries waiting for admission");
+}
+
+bool AdmissionControl::fits(const Query &query) const {
+  auto limit = _limits.queriesPerPriority.find(query.priority);
+  if (limit != _limits.queriesPerPriority.end()) {
+    auto running = _runningPerPriority.find(query.priority);
+    if (running != _runningPerPriority.end() && running->second >= limit->second) {
+      return false;
+    }
+  }
+
+  if (_limits.queriesPerSession > 0 && query.sessionId != 0) {
+    auto running = _runningPerSession.find(query.sessionId);
+    if (running != _runningPerSession.end() && running->second >= _limits.queriesPerSession) {
+      return false;
+    }
+  }
+
+  // A query with more tasks than the limit runs alone instead of never
+  if (_limits.tasks > 0 && _runningTasks > 0 && _runningTasks + query.tasks > _limits.tasks) {
+    return false;
+  }
+  return true;
+}
+
+bool AdmissionControl::waitingAhead(const Query &query) const {
+  // Queries of a priority or session are admitted in order
+  return std::any_of(_waiting.begin(), _waiting.end(), [&query] (const Query& waiting) {
+      return waiting.priority == query.priority || (query.sessionId != 0 && waiting.sessionId == query.sessionId);
+    });
+}
+
+void AdmissionControl::acquire(const Query &query) {
+  ++_running;
+  _runningTasks += query.tasks;
+  ++_runningPerPriority[query.priority];
+  if (query.sessionId != 0) {
+    ++_runningPerSession[query.sessionId];
+  }
+}
+
+void AdmissionControl::release(int priority, int sessionId, size_t tasks) {
+  std::vector<Query> admitted;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_running;
+    _runningTasks -= tasks;
+    if (--_runningPerPriority[priority] == 0) {
+      _runningPerPriority.erase(priority);
+    }
+    if (sessionId != 0 && --_runningPerSession[sessionId] == 0) {
+      _runningPerSession.erase(sessionId);
+    }
+
+    // Admit waiting queries in order, later queries of other priorities
+    // and sessions may pass a query that does not fit yet
+    std::deque<Query> waiting;
+    waiting.swap(_waiting);
+    for (auto& query : waiting) {
+      if (!waitingAhead(query) && fits(query)) {
+        acquire(query);
+        admitted.push_back(std::move(query));
+      } else {
+        _waiting.push_back(std::move(query));
+      }
+    }
+  }
+
+  for (auto& query : admitted) {
+    query.admitted(std::unique_ptr<AdmissionTicket>(
+        new AdmissionTicket(*this, query.priority, query.sessionId, query.tasks)));
+  }
+}
+
+void AdmissionControl::expireWaiting() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stop) {
+    if (_waiting.empty()) {
+      _expireCondition.wait(lock);
+      continue;
+    }
+
+    const auto now = clock_t::now();
+    std::vector<Query> expired;
+    auto next = clock_t::time_point::max();
+    for (auto it = _waiting.begin(); it != _waiting.end();) {
+      if (it->deadline <= now) {
+        expired.push_back(std::move(*it));
+        it = _waiting.erase(it);
+      } else {
+        next = std::min(next, it->deadline);
+        ++it;
+      }
+    }
+
+    if (!expired.empty()) {
+      lock.unlock();
+      LOG4CXX_WARN(_logger, "Rejecting " << expired.size() << " queries after admission timeout");
+      for (auto& query : expired) {
+        query.rejected("AdmissionControl: timeout while waiting for admission");
+      }
+      lock.lock();
+    } else {
+      _expireCondition.wait_until(lock, next);
+    }
+  }
+}
+
+}
+}
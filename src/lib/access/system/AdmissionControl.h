@@ -0,0 +1,117 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_ADMISSIONCONTROL_H_
+#define SRC_LIB_ACCESS_ADMISSIONCONTROL_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace hyrise {
+namespace access {
+
+struct AdmissionLimits {
+  // Concurrent queries per priority, priorities without entry are unlimited
+  std::map<int, size_t> queriesPerPriority;
+  // Concurrent queries per session, sessionId 0 is no session. 0 is unlimited
+  size_t queriesPerSession = 0;
+  // Operator tasks of all admitted queries. 0 is unlimited
+  size_t tasks = 0;
+  // Queries waiting for admission, further queries are rejected
+  size_t queueLength = 1024;
+  // Queries waiting longer are rejected
+  std::chrono::milliseconds timeout = std::chrono::milliseconds(10000);
+};
+
+class AdmissionControl;
+
+/// Admission of one query, released when destroyed
+class AdmissionTicket {
+ public:
+  ~AdmissionTicket();
+
+ private:
+  friend class AdmissionControl;
+  AdmissionTicket(AdmissionControl &control, int priority, int sessionId, size_t tasks);
+
+  AdmissionControl &_control;
+  int _priority;
+  int _sessionId;
+  size_t _tasks;
+};
+
+/*
+ * Limits the number of concurrently executed queries per priority and
+ * session, and the number of their operator tasks. RequestParseTask
+ * schedules a plan only once it is admitted. Queries exceeding a limit
+ * wait in a bounded FIFO queue and are admitted when running queries
+ * finish, or rejected after the timeout. Without limits every query is
+ * admitted right away.
+ */
+class AdmissionControl {
+ public:
+  typedef std::function<void(std::unique_ptr<AdmissionTicket>)> admitted_fn_t;
+  typedef std::function<void(const std::string&)> rejected_fn_t;
+
+  static AdmissionControl &getInstance();
+
+  ~AdmissionControl();
+
+  void setLimits(const AdmissionLimits &limits);
+  AdmissionLimits getLimits() const;
+
+  /*  Calls admitted with the ticket of the query, right away or once
+      other queries finished, or rejected with the reason. Both are
+      called without holding locks, possibly from another thread.  */
+  void admit(int priority, int sessionId, size_t tasks, admitted_fn_t admitted, rejected_fn_t rejected);
+
+  size_t running() const;
+  size_t waiting() const;
+
+ private:
+  friend class AdmissionTicket;
+  typedef std::chrono::steady_clock clock_t;
+
+  struct Query {
+    int priority;
+    int sessionId;
+    size_t tasks;
+    clock_t::time_point deadline;
+    admitted_fn_t admitted;
+    rejected_fn_t rejected;
+  };
+
+  AdmissionControl() {}
+
+  // The mutex has to be held for the following
+  bool fits(const Query &query) const;
+  bool waitingAhead(const Query &query) const;
+  void acquire(const Query &query);
+
+  void release(int priority, int sessionId, size_t tasks);
+  // Rejects queries waiting longer than the timeout
+  void expireWaiting();
+
+  mutable std::mutex _mutex;
+  std::condition_variable _expireCondition;
+  AdmissionLimits _limits;
+
+  size_t _running = 0;
+  size_t _runningTasks = 0;
+  std::map<int, size_t> _runningPerPriority;
+  std::map<int, size_t> _runningPerSession;
+  std::deque<Query> _waiting;
+
+  std::thread _expireThread;
+  bool _stop = false;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_ADMISSIONCONTROL_H_
@@ -0,0 +1,165 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/BinaryResponse.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "storage/AbstractTable.h"
+#include "storage/SimpleStore.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+const size_t batchRows = 1024;
+
+template <typename V>
+void append(std::string &out, const V &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(V));
+}
+
+void pad(std::string &out) {
+  out.resize((out.size() + 7) & ~static_cast<size_t>(7), '\0');
+}
+
+template <typename T> struct binary_column_type;
+template <> struct binary_column_type<hyrise_int_t> { static const uint32_t value = BinaryInt; };
+template <> struct binary_column_type<hyrise_int32_t> { static const uint32_t value = BinaryInt32; };
+template <> struct binary_column_type<hyrise_float_t> { static const uint32_t value = BinaryFloat; };
+template <> struct binary_column_type<hyrise_string_t> { static const uint32_t value = BinaryString; };
+
+struct column_type_functor {
+  typedef uint32_t value_type;
+
+  template <typename T>
+  value_type operator()() {
+    return binary_column_type<T>::value;
+  }
+};
+
+template <typename T>
+void readValues(const storage::c_atable_ptr_t &table, size_t column, size_t row, size_t count, T *buffer) {
+  table->getValueRange<T>(column, row, count, buffer);
+}
+
+// The delta of a SimpleStore has no dictionary and is only accessible
+// through SimpleStore::getValue
+template <typename T>
+void readValues(const std::shared_ptr<const storage::SimpleStore> &table, size_t column, size_t row, size_t count, T *buffer) {
+  for (size_t i = 0; i < count; ++i) {
+    buffer[i] = table->getValue<T>(column, row + i);
+  }
+}
+
+template <typename TableType, typename T>
+void writeColumn(std::string &out, const TableType &table, size_t column, size_t first, size_t count, T*) {
+  T buffer[batchRows];
+  for (size_t offset = 0; offset < count; offset += batchRows) {
+    const size_t n = std::min(batchRows, count - offset);
+    readValues(table, column, first + offset, n, buffer);
+    out.append(reinterpret_cast<const char *>(buffer), n * sizeof(T));
+  }
+  pad(out);
+}
+
+template <typename TableType>
+void writeColumn(std::string &out, const TableType &table, size_t column, size_t first, size_t count, hyrise_string_t*) {
+  std::vector<uint64_t> offsets;
+  offsets.reserve(count + 1);
+  std::string data;
+
+  hyrise_string_t buffer[batchRows];
+  for (size_t offset = 0; offset < count; offset += batchRows) {
+    const size_t n = std::min(batchRows, count - offset);
+    readValues(table, column, first + offset, n, buffer);
+    for (size_t i = 0; i < n; ++i) {
+      offsets.push_back(data.size());
+      data.append(buffer[i]);
+    }
+  }
+  offsets.push_back(data.size());
+
+  out.append(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+  out.append(data);
+  pad(out);
+}
+
+template <typename TableType>
+struct column_writer_functor {
+  typedef void value_type;
+
+  std::string &out;
+  const TableType &table;
+  size_t column;
+  size_t first;
+  size_t count;
+
+  column_writer_functor(std::string &out, const TableType &table, size_t first, size_t count) :
+      out(out), table(table), column(0), first(first), count(count) {}
+
+  template <typename T>
+  value_type operator()() {
+    writeColumn(out, table, column, first, count, static_cast<T*>(nullptr));
+  }
+};
+
+template <typename TableType>
+void writeColumns(std::string &out, const TableType &table, size_t first, size_t count) {
+  storage::type_switch<hyrise_basic_types> ts;
+  column_writer_functor<TableType> fun(out, table, first, count);
+  for (size_t column = 0; column < table->columnCount(); ++column) {
+    fun.column = column;
+    ts(table->typeOfColumn(column), fun);
+  }
+}
+
+}  // namespace
+
+std::string generateBinaryResponse(const storage::c_atable_ptr_t &table,
+                                   const Json::Value &metadata,
+                                   const size_t transmitLimit,
+                                   const size_t transmitOffset) {
+  const size_t size = table ? table->size() : 0;
+  const size_t first = std::min(transmitOffset, size);
+  const size_t count = (transmitLimit > 0) ? std::min(transmitLimit, size - first) : size - first;
+  const uint32_t columns = table ? table->columnCount() : 0;
+
+  Json::FastWriter fw;
+  const std::string json = fw.write(metadata);
+
+  std::string out;
+  out.reserve(32 + json.size() + count * columns * sizeof(hyrise_int_t));
+  out.append("HYRC", 4);
+  append(out, binaryResponseVersion);
+  append(out, static_cast<uint32_t>(json.size()));
+  append(out, columns);
+  append(out, static_cast<uint64_t>(count));
+  out.append(json);
+  pad(out);
+
+  if (!table) {
+    return out;
+  }
+
+  storage::type_switch<hyrise_basic_types> ts;
+  column_type_functor type_fun;
+  for (size_t column = 0; column < columns; ++column) {
+    const std::string &name = table->nameOfColumn(column);
+    append(out, ts(table->typeOfColumn(column), type_fun));
+    append(out, static_cast<uint32_t>(name.size()));
+    out.append(name);
+    pad(out);
+  }
+
+  if (const auto &store = std::dynamic_pointer_cast<const storage::SimpleStore>(table)) {
+    writeColumns(out, store, first, count);
+  } else {
+    writeColumns(out, table, first, count);
+  }
+  return out;
+}
+
+}
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_BINARYRESPONSE_H_
+#define SRC_LIB_ACCESS_BINARYRESPONSE_H_
+
+#include <cstdint>
+#include <string>
+
+#include <json.h>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Binary columnar encoding of a query result, selected with the POST
+ * parameter format=binary. All numbers are little endian and every
+ * section starts at a multiple of 8 bytes.
+ *
+ *   char[4]   magic "HYRC"
+ *   uint32    format version
+ *   uint32    length m of the metadata
+ *   uint32    number of columns c
+ *   uint64    number of rows n
+ *   m bytes   metadata, the JSON response without "rows"
+ *
+ *   c column descriptors:
+ *     uint32  column type, see BinaryColumnType
+ *     uint32  length l of the column name
+ *     l bytes column name
+ *
+ *   c columns of n values:
+ *     Int, Int32, Float: n values of 8, 4 or 4 bytes
+ *     String:            n + 1 uint64 offsets into the following
+ *                        string data, value i is [offset i, offset i+1)
+ */
+enum BinaryColumnType : uint32_t {
+  BinaryInt = 0,
+  BinaryFloat = 1,
+  BinaryString = 2,
+  BinaryInt32 = 3
+};
+
+static const uint32_t binaryResponseVersion = 1;
+static const char binaryResponseContentType[] = "application/x-hyrise-columnar";
+
+/*
+ * Encodes the rows [transmitOffset, transmitOffset + transmitLimit) of
+ * table, all rows from transmitOffset for a limit of 0. A null table
+ * results in a response without columns.
+ */
+std::string generateBinaryResponse(const storage::c_atable_ptr_t &table,
+                                   const Json::Value &metadata,
+                                   size_t transmitLimit,
+                                   size_t transmitOffset);
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_BINARYRESPONSE_H_
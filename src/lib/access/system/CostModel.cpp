@@ -0,0 +1,226 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/CostModel.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "log4cxx/logger.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+auto logger = log4cxx::Logger::getLogger("access.CostModel");
+
+// Weight of the previous observations when adding one; about the last
+// 200 parallelized operations determine a model
+const double decay = 0.995;
+// Weight of the prior, in observations; it only keeps the solution
+// stable while the sizes and instances seen are too similar
+const double ridge = 0.01;
+
+const char *parameterNames[] = {"a_a", "a_b", "min_mts_a", "min_mts_b"};
+
+// Solves A x = b by Gaussian elimination, false if A is singular
+template <size_t N>
+bool solve(std::array<double, N * N> a, std::array<double, N> b, std::array<double, N>& x) {
+  for (size_t col = 0; col < N; ++col) {
+    size_t pivot = col;
+    for (size_t row = col + 1; row < N; ++row) {
+      if (std::fabs(a[row * N + col]) > std::fabs(a[pivot * N + col]))
+        pivot = row;
+    }
+    if (std::fabs(a[pivot * N + col]) < 1e-12)
+      return false;
+    if (pivot != col) {
+      for (size_t i = 0; i < N; ++i)
+        std::swap(a[col * N + i], a[pivot * N + i]);
+      std::swap(b[col], b[pivot]);
+    }
+    for (size_t row = col + 1; row < N; ++row) {
+      const double factor = a[row * N + col] / a[col * N + col];
+      for (size_t i = col; i < N; ++i)
+        a[row * N + i] -= factor * a[col * N + i];
+      b[row] -= factor * b[col];
+    }
+  }
+  for (size_t col = N; col-- > 0;) {
+    double sum = b[col];
+    for (size_t i = col + 1; i < N; ++i)
+      sum -= a[col * N + i] * x[i];
+    x[col] = sum / a[col * N + col];
+  }
+  return true;
+}
+
+Json::Value toArray(const double *values, size_t size) {
+  Json::Value result(Json::arrayValue);
+  for (size_t i = 0; i < size; ++i)
+    result.append(values[i]);
+  return result;
+}
+
+void fromArray(const Json::Value& array, double *values, size_t size) {
+  if (!array.isArray() || array.size() != size)
+    throw std::runtime_error("Cost model has wrong number of values");
+  for (size_t i = 0; i < size; ++i)
+    values[i] = array[static_cast<Json::ArrayIndex>(i)].asDouble();
+}
+
+std::string hostName() {
+  char name[256] = {0};
+  if (gethostname(name, sizeof(name) - 1) != 0)
+    return "unknown";
+  return name;
+}
+}
+
+const size_t CostModel::parameterCount;
+const size_t CostModel::minimumObservations;
+
+CostModel::parameters_t CostModel::features(double aTerm, double minMtsTerm, size_t instances) {
+  const double x = static_cast<double>(std::max<size_t>(instances, 1));
+  return {{aTerm / x, 1.0 / x, minMtsTerm, 1.0}};
+}
+
+void CostModel::observe(const parameters_t& features, double milliseconds) {
+  for (size_t i = 0; i < parameterCount; ++i) {
+    for (size_t j = 0; j < parameterCount; ++j)
+      _xtx[i * parameterCount + j] = decay * _xtx[i * parameterCount + j] + features[i] * features[j];
+    _xty[i] = decay * _xty[i] + features[i] * milliseconds;
+  }
+  ++_observations;
+}
+
+CostModel::parameters_t CostModel::parameters() const {
+  if (_observations < minimumObservations)
+    return _prior;
+  // (X'X + ridge I) p = X'y + ridge prior
+  auto a = _xtx;
+  auto b = _xty;
+  for (size_t i = 0; i < parameterCount; ++i) {
+    a[i * parameterCount + i] += ridge;
+    b[i] += ridge * _prior[i];
+  }
+  parameters_t result;
+  if (!solve<parameterCount>(a, b, result))
+    return _prior;
+  return result;
+}
+
+Json::Value CostModel::toJson() const {
+  Json::Value result;
+  result["observations"] = Json::Value(static_cast<Json::UInt64>(_observations));
+  result["xtx"] = toArray(_xtx.data(), _xtx.size());
+  result["xty"] = toArray(_xty.data(), _xty.size());
+  result["prior"] = toArray(_prior.data(), _prior.size());
+  const auto learned = parameters();
+  for (size_t i = 0; i < parameterCount; ++i)
+    result["parameters"][parameterNames[i]] = learned[i];
+  return result;
+}
+
+void CostModel::fromJson(const Json::Value& value) {
+  fromArray(value["xtx"], _xtx.data(), _xtx.size());
+  fromArray(value["xty"], _xty.data(), _xty.size());
+  fromArray(value["prior"], _prior.data(), _prior.size());
+  _observations = value["observations"].asUInt64();
+}
+
+CostModels::CostModels() : _host(hostName()) {}
+
+CostModels &CostModels::getInstance() {
+  static CostModels models;
+  return models;
+}
+
+CostModel::parameters_t CostModels::parameters(const std::string& operation, const CostModel::parameters_t& prior) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& model = _models[operation];
+  model.setPrior(prior);
+  return model.parameters();
+}
+
+void CostModels::observe(const std::string& operation, const CostModel::parameters_t& features, double milliseconds) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _models[operation].observe(features, milliseconds);
+}
+
+size_t CostModels::observations(const std::string& operation) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _models.find(operation);
+  return it == _models.end() ? 0 : it->second.observations();
+}
+
+Json::Value CostModels::toJson() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Json::Value result;
+  result["host"] = _host;
+  result["operations"] = Json::Value(Json::objectValue);
+  for (const auto& model : _models)
+    result["operations"][model.first] = model.second.toJson();
+  return result;
+}
+
+bool CostModels::load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open())
+    return false;
+  Json::Value value;
+  Json::Reader reader;
+  if (!reader.parse(file, value)) {
+    LOG4CXX_WARN(logger, "Could not parse cost models " << path << ": " << reader.getFormattedErrorMessages());
+    return false;
+  }
+  if (value["host"].asString() != _host) {
+    LOG4CXX_WARN(logger, "Ignoring cost models " << path << " of host " << value["host"].asString());
+    return false;
+  }
+  std::map<std::string, CostModel> models;
+  try {
+    const auto& operations = value["operations"];
+    for (const auto& name : operations.getMemberNames())
+      models[name].fromJson(operations[name]);
+  } catch (const std::exception& e) {
+    LOG4CXX_WARN(logger, "Could not load cost models " << path << ": " << e.what());
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  _models = std::move(models);
+  return true;
+}
+
+bool CostModels::save(const std::string& path) const {
+  const auto value = toJson();
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    LOG4CXX_WARN(logger, "Could not write cost models to " << path);
+    return false;
+  }
+  Json::StyledWriter writer;
+  file << writer.write(value);
+  return file.good();
+}
+
+void CostModels::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _models.clear();
+}
+
+CostObservation::CostObservation(const std::string& operation, const CostModel::parameters_t& features, size_t tasks)
+    : _operation(operation), _features(features), _tasks(tasks), _pending(tasks), _nanoseconds(0) {}
+
+void CostObservation::taskDone(epoch_t nanoseconds) {
+  _nanoseconds += nanoseconds;
+  if (--_pending == 0) {
+    const double meanMilliseconds = _nanoseconds.load() / 1e6 / _tasks;
+    CostModels::getInstance().observe(_operation, _features, meanMilliseconds);
+  }
+}
+
+}}
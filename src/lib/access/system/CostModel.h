@@ -0,0 +1,105 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_COSTMODEL_H_
+#define SRC_LIB_ACCESS_COSTMODEL_H_
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "helper/epoch.h"
+#include "json.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Online fit of the mean task time model of dynamic parallelization
+ *
+ *   mts = (a_a * f(s) + a_b) / instances + min_mts_a * g(s) + min_mts_b
+ *
+ * for one operation, with s the input size in 100k rows and the
+ * operation specific terms f and g. Only the sums of X'X and X'y are
+ * kept, decayed so that the model follows changes of the host. The
+ * parameters are solved as ridge regression towards the offline fit
+ * of the operation, which is used until enough tasks were measured.
+ */
+class CostModel {
+ public:
+  static const size_t parameterCount = 4;
+  /// a_a, a_b, min_mts_a, min_mts_b
+  typedef std::array<double, parameterCount> parameters_t;
+
+  /// Observations before the learned parameters are used
+  static const size_t minimumObservations = 16;
+
+  /// Features of a measurement with the terms f(s) and g(s)
+  static parameters_t features(double aTerm, double minMtsTerm, size_t instances);
+
+  void observe(const parameters_t& features, double milliseconds);
+  /// The offline fit of the operation
+  void setPrior(const parameters_t& prior) { _prior = prior; }
+  parameters_t parameters() const;
+  size_t observations() const { return _observations; }
+
+  Json::Value toJson() const;
+  void fromJson(const Json::Value& value);
+
+ private:
+  std::array<double, parameterCount * parameterCount> _xtx {};
+  parameters_t _xty {};
+  parameters_t _prior {};
+  size_t _observations = 0;
+};
+
+/*
+ * The cost models of all operations on this host. Models are stored
+ * with the host name and only loaded on the same host, the offline
+ * constants of the operations apply elsewhere.
+ */
+class CostModels {
+ public:
+  static CostModels &getInstance();
+
+  /// The learned parameters of the operation, or its offline fit prior
+  CostModel::parameters_t parameters(const std::string& operation, const CostModel::parameters_t& prior);
+  void observe(const std::string& operation, const CostModel::parameters_t& features, double milliseconds);
+  size_t observations(const std::string& operation) const;
+
+  /// Models with their sums, observations and current parameters
+  Json::Value toJson() const;
+  /// Returns false if the file is missing or belongs to another host
+  bool load(const std::string& path);
+  bool save(const std::string& path) const;
+  void clear();
+
+  const std::string& host() const { return _host; }
+
+ private:
+  CostModels();
+
+  std::string _host;
+  mutable std::mutex _mutex;
+  std::map<std::string, CostModel> _models;
+};
+
+/// Measures the instances of one dynamically parallelized operation and
+/// adds their mean task time to its model once all have executed
+class CostObservation {
+ public:
+  CostObservation(const std::string& operation, const CostModel::parameters_t& features, size_t tasks);
+
+  void taskDone(epoch_t nanoseconds);
+
+ private:
+  const std::string _operation;
+  const CostModel::parameters_t _features;
+  const size_t _tasks;
+  std::atomic<size_t> _pending;
+  std::atomic<epoch_t> _nanoseconds;
+};
+
+}}
+
+#endif  // SRC_LIB_ACCESS_COSTMODEL_H_
@@ -0,0 +1,16 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/MorselCursor.h"
+
+namespace hyrise {
+namespace access {
+
+const size_t MorselCursor::defaultMorselSize;
+const size_t MorselCursor::morselsPerInstance;
+const size_t MorselCursor::minimumMorselSize;
+
+size_t MorselCursor::morselSizeFor(size_t size, size_t instances) {
+  const size_t balanced = size / (std::max<size_t>(instances, 1) * morselsPerInstance);
+  return std::max(minimumMorselSize, std::min(defaultMorselSize, balanced));
+}
+
+}}
@@ -0,0 +1,54 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_MORSELCURSOR_H_
+#define SRC_LIB_ACCESS_MORSELCURSOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Hands out the input of one operation in morsels of a fixed number of
+ * units (rows or keys). The instances of the operation share the cursor
+ * and pull morsels until the input is exhausted, so an instance that
+ * is slow or starts late simply processes fewer morsels. Morsels are
+ * handed out in ascending order.
+ */
+class MorselCursor {
+ public:
+  /// Morsel size for large inputs
+  static const size_t defaultMorselSize = 100000;
+  /// Morsels every instance should get at least on small inputs
+  static const size_t morselsPerInstance = 4;
+  static const size_t minimumMorselSize = 1024;
+
+  MorselCursor(size_t size, size_t morselSize) : _size(size), _morselSize(std::max<size_t>(morselSize, 1)), _position(0) {}
+
+  /// Fixed morsel size for `size` units processed by `instances`
+  static size_t morselSizeFor(size_t size, size_t instances);
+
+  /// Claims the next morsel [first, last), false once the input is exhausted
+  bool next(size_t &first, size_t &last) {
+    if (_position.load(std::memory_order_relaxed) >= _size)
+      return false;
+    first = _position.fetch_add(_morselSize, std::memory_order_relaxed);
+    if (first >= _size)
+      return false;
+    last = std::min(first + _morselSize, _size);
+    return true;
+  }
+
+  size_t size() const { return _size; }
+  size_t morselSize() const { return _morselSize; }
+
+ private:
+  const size_t _size;
+  const size_t _morselSize;
+  std::atomic<size_t> _position;
+};
+
+}}
+
+#endif  // SRC_LIB_ACCESS_MORSELCURSOR_H_
@@ -1,5 +1,10 @@
 #include "access/system/ParallelizablePlanOperation.h"
 
+#include <stdexcept>
+
+#include "access/UnionAll.h"
+#include "access/system/MorselCursor.h"
+#include "access/system/ResponseTask.h"
 #include "storage/TableRangeView.h"
 
 namespace hyrise {  namespace access {
@@ -15,6 +20,9 @@ std::pair<std::uint64_t, std::uint64_t> ParallelizablePlanOperation::distribute(
 }
 
 void ParallelizablePlanOperation::splitInput() {
+  // morsel-driven instances keep the whole input
+  if (_morsels)
+    return;
   const auto& tables = input.getTables();
   if (_count > 0 && !tables.empty()) {
     auto r = distribute(tables[0]->size(), _part, _count);
@@ -35,4 +43,102 @@ void ParallelizablePlanOperation::setCount(size_t count) {
   _count = count;
 }
 
+void ParallelizablePlanOperation::setMorsels(const std::shared_ptr<MorselCursor>& morsels) {
+  _morsels = morsels;
+}
+
+std::shared_ptr<ParallelizablePlanOperation> ParallelizablePlanOperation::createInstance() {
+  throw std::runtime_error(vname() + " does not support morsel-driven execution");
+}
+
+std::shared_ptr<PlanOperation> ParallelizablePlanOperation::createMerge() {
+  auto unionall = std::make_shared<UnionAll>();
+  unionall->setPlanOperationName("UnionAll");
+  return unionall;
+}
+
+std::vector<taskscheduler::task_ptr_t> ParallelizablePlanOperation::applyMorselParallelization(size_t dynamicCount, size_t size) {
+  std::vector<taskscheduler::task_ptr_t> tasks;
+
+  // if no parallelization is necessary, just return this task again as is
+  if (dynamicCount <= 1 || size == 0) {
+    tasks.push_back(shared_from_this());
+    return tasks;
+  }
+
+  std::vector<taskscheduler::task_ptr_t> successors;
+  {
+    std::lock_guard<decltype(_observerMutex)> lk(_observerMutex);
+    // get successors of current task
+    for (auto doneObserver : _doneObservers) {
+      auto const task = std::dynamic_pointer_cast<taskscheduler::Task>(doneObserver.lock());
+      successors.push_back(task);
+    }
+    // remove done observers from current task
+    _doneObservers.clear();
+  }
+
+  auto morsels = std::make_shared<MorselCursor>(size, MorselCursor::morselSizeFor(size, dynamicCount));
+
+  // this task is the first instance
+  setMorsels(morsels);
+  tasks.push_back(std::static_pointer_cast<taskscheduler::Task>(shared_from_this()));
+  std::string opIdBase = _operatorId;
+  _operatorId = opIdBase + "_0";
+
+  // create other instances
+  for (size_t i = 1; i < dynamicCount; i++) {
+    auto t = createInstance();
+
+    t->setOperatorId(opIdBase + "_" + std::to_string(i));
+    t->setProducesPositions(producesPositions);
+    t->setMorsels(morsels);
+    t->setPriority(_priority);
+    t->setSessionId(_sessionId);
+    t->setQueryId(_queryId);
+    t->setPlanId(_planId);
+    t->setTXContext(_txContext);
+    t->setId(_txContext.tid);
+    t->setEvent(_papiEvent);
+
+    // set dependencies equal to current task
+    for (auto d : _dependencies)
+      t->addDoneDependency(d);
+
+    t->setPlanOperationName(planOperationName());
+    if (auto responseTask = getResponseTask()) {
+      responseTask->registerPlanOperation(t);
+    }
+
+    tasks.push_back(t);
+  }
+
+  // create merge and set dependencies
+  auto merge = createMerge();
+  merge->setOperatorId(opIdBase + "_union");
+  merge->setProducesPositions(producesPositions);
+  merge->setPriority(_priority);
+  merge->setSessionId(_sessionId);
+  merge->setQueryId(_queryId);
+  merge->setPlanId(_planId);
+  merge->setTXContext(_txContext);
+  merge->setId(_txContext.tid);
+  merge->setEvent(_papiEvent);
+
+  for (auto t : tasks)
+    merge->addDependency(t);
+
+  // set merge as dependency to all successors
+  for (auto successor : successors)
+    successor->changeDependency(std::dynamic_pointer_cast<taskscheduler::Task>(shared_from_this()), merge);
+
+  if (auto responseTask = getResponseTask()) {
+    responseTask->registerPlanOperation(merge);
+  }
+
+  tasks.push_back(merge);
+
+  return tasks;
+}
+
 }}
@@ -5,6 +5,8 @@
 
 namespace hyrise { namespace access {
 
+class MorselCursor;
+
 class ParallelizablePlanOperation : public PlanOperation {
  public:
   /// Compute start and end for accessing partition `part` of `count`
@@ -20,9 +22,25 @@ class ParallelizablePlanOperation : public PlanOperation {
 
   void setPart(size_t part);
   void setCount(size_t count);
+  /// Instead of a fixed part, the instance pulls morsels of its input
+  /// from the cursor shared with the other instances
+  void setMorsels(const std::shared_ptr<MorselCursor>& morsels);
  protected:
+  /// Morsel-driven dynamic parallelization: `dynamicCount` instances of
+  /// this operation share a cursor over the `size` units of the input and
+  /// the operation of createMerge merges their results for the successors
+  std::vector<taskscheduler::task_ptr_t> applyMorselParallelization(size_t dynamicCount, size_t size);
+  /// Creates a further instance of this operation for
+  /// applyMorselParallelization, which copies the common settings
+  virtual std::shared_ptr<ParallelizablePlanOperation> createInstance();
+  /// Merges the results of the instances, a UnionAll by default. The
+  /// instances take morsels in any order, so the merge has to restore
+  /// the order of the input if the successors rely on it
+  virtual std::shared_ptr<PlanOperation> createMerge();
+
   size_t _part = 0;
   size_t _count = 0;
+  std::shared_ptr<MorselCursor> _morsels;
 };
 
 }}
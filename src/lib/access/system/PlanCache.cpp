@@ -0,0 +1,80 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/PlanCache.h"
+
+#include "access/system/QueryParser.h"
+
+namespace hyrise {
+namespace access {
+
+const std::string PreparedPlan::placeholderKey = "$param";
+
+PreparedPlan::PreparedPlan(const Json::Value &plan) : _plan(plan) {
+  path_t path;
+  collectParameters(_plan, path);
+}
+
+void PreparedPlan::collectParameters(const Json::Value &node, path_t &path) {
+  if (node.isObject()) {
+    if (node.size() == 1 && node.isMember(placeholderKey)) {
+      _parameters.push_back(std::make_pair(path, node[placeholderKey].asString()));
+      return;
+    }
+    for (const auto &name : node.getMemberNames()) {
+      path.push_back(Json::Value(name));
+      collectParameters(node[name], path);
+      path.pop_back();
+    }
+  } else if (node.isArray()) {
+    for (Json::ArrayIndex i = 0; i < node.size(); ++i) {
+      path.push_back(Json::Value(i));
+      collectParameters(node[i], path);
+      path.pop_back();
+    }
+  }
+}
+
+Json::Value PreparedPlan::bind(const Json::Value &parameters) const {
+  Json::Value plan(_plan);
+  for (const auto &parameter : _parameters) {
+    if (!parameters.isMember(parameter.second)) {
+      throw QueryParserException("No value for parameter " + parameter.second);
+    }
+
+    Json::Value *node = &plan;
+    for (const auto &step : parameter.first) {
+      node = step.isString() ? &(*node)[step.asString()] : &(*node)[step.asUInt()];
+    }
+    *node = parameters[parameter.second];
+  }
+  return plan;
+}
+
+PlanCache &PlanCache::getInstance() {
+  static PlanCache cache;
+  return cache;
+}
+
+void PlanCache::add(const std::string &handle, const Json::Value &plan) {
+  auto prepared = std::make_shared<const PreparedPlan>(plan);
+  std::lock_guard<std::mutex> guard(_mutex);
+  _plans[handle] = prepared;
+}
+
+std::shared_ptr<const PreparedPlan> PlanCache::get(const std::string &handle) const {
+  std::lock_guard<std::mutex> guard(_mutex);
+  const auto it = _plans.find(handle);
+  return (it != _plans.end()) ? it->second : nullptr;
+}
+
+bool PlanCache::remove(const std::string &handle) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  return _plans.erase(handle) > 0;
+}
+
+void PlanCache::clear() {
+  std::lock_guard<std::mutex> guard(_mutex);
+  _plans.clear();
+}
+
+}
+}
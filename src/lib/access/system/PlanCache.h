@@ -0,0 +1,75 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_PLANCACHE_H_
+#define SRC_LIB_ACCESS_PLANCACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <json.h>
+
+namespace hyrise {
+namespace access {
+
+/*
+ * A parsed and transformed query plan with parameter placeholders.
+ * A placeholder is an object of the form {"$param": "name"} at any
+ * position of the plan, e.g. as the value of a predicate.
+ */
+class PreparedPlan {
+ public:
+  explicit PreparedPlan(const Json::Value &plan);
+
+  /*  Returns a copy of the plan with every placeholder replaced by the
+      value of its name in parameters. Throws a QueryParserException if
+      a parameter has no value.  */
+  Json::Value bind(const Json::Value &parameters) const;
+
+  size_t parameterCount() const { return _parameters.size(); }
+
+  static const std::string placeholderKey;
+
+ private:
+  // Member names and array indices leading from the root to a placeholder
+  typedef std::vector<Json::Value> path_t;
+
+  void collectParameters(const Json::Value &node, path_t &path);
+
+  Json::Value _plan;
+  std::vector<std::pair<path_t, std::string> > _parameters;
+};
+
+/*
+ * Server wide cache of prepared plans. Clients register a plan under a
+ * handle once ("prepare" in RequestParseTask) and then execute it by
+ * handle ("plan" and "parameters"), which skips parsing the query string
+ * and the QueryTransformationEngine.
+ */
+class PlanCache {
+ public:
+  static PlanCache &getInstance();
+
+  //  Registers plan under handle, replacing a previous plan of that handle
+  void add(const std::string &handle, const Json::Value &plan);
+
+  //  Returns the plan registered under handle, nullptr if there is none
+  std::shared_ptr<const PreparedPlan> get(const std::string &handle) const;
+
+  bool remove(const std::string &handle);
+
+  void clear();
+
+ private:
+  PlanCache() {}
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<const PreparedPlan> > _plans;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_PLANCACHE_H_
@@ -4,6 +4,9 @@
 #include <algorithm>
 #include <thread>
 
+#include "access/UnionAll.h"
+#include "access/UnionScan.h"
+#include "access/system/CostModel.h"
 #include "access/system/ResponseTask.h"
 #include "helper/epoch.h"
 #include "helper/PapiTracer.h"
@@ -26,11 +29,13 @@ size_t PlanOperation::getTotalTableSize(){
 }
 
 double PlanOperation::calcMinMts(double totalTblSizeIn100k) {
-  return min_mts_a() * totalTblSizeIn100k + min_mts_b();
+  const auto parameters = CostModels::getInstance().parameters(vname(), {{a_a(), a_b(), min_mts_a(), min_mts_b()}});
+  return parameters[2] * minMtsTerm(totalTblSizeIn100k) + parameters[3];
 }
 
 double PlanOperation::calcA(double  totalTblSizeIn100k) {
-  return a_a() * totalTblSizeIn100k + a_b();
+  const auto parameters = CostModels::getInstance().parameters(vname(), {{a_a(), a_b(), min_mts_a(), min_mts_b()}});
+  return parameters[0] * aTerm(totalTblSizeIn100k) + parameters[1];
 }
 
 size_t PlanOperation::determineDynamicCount(size_t maxTaskRunTime) {
@@ -48,6 +53,7 @@ size_t PlanOperation::determineDynamicCount(size_t maxTaskRunTime) {
   }
   
   auto totalTblSizeIn100k = totalTableSize / 100000.0;
+  _dynamicTableSize = totalTblSizeIn100k;
 
   // this is the b of the mts = a / instances + b  model
   auto minMts = calcMinMts(totalTblSizeIn100k);
@@ -65,6 +71,25 @@ size_t PlanOperation::determineDynamicCount(size_t maxTaskRunTime) {
   return numTasks;
 }
 
+void PlanOperation::notifyParallelized(const std::vector<taskscheduler::task_ptr_t>& instances, size_t dynamicCount) {
+  if (_dynamicTableSize <= 0)
+    return;
+  std::vector<std::shared_ptr<PlanOperation>> operations;
+  for (const auto& instance : instances) {
+    // the union merging the instances is not an instance of the model
+    if (std::dynamic_pointer_cast<UnionAll>(instance) || std::dynamic_pointer_cast<UnionScan>(instance))
+      continue;
+    if (auto operation = std::dynamic_pointer_cast<PlanOperation>(instance))
+      operations.push_back(operation);
+  }
+  if (operations.empty())
+    return;
+  const auto features = CostModel::features(aTerm(_dynamicTableSize), minMtsTerm(_dynamicTableSize), dynamicCount);
+  auto observation = std::make_shared<CostObservation>(vname(), features, operations.size());
+  for (const auto& operation : operations)
+    operation->_costObservation = observation;
+}
+
 PlanOperation::~PlanOperation() = default;
 
 void PlanOperation::addResult(storage::c_aresource_ptr_t result) {
@@ -92,6 +117,10 @@ storage::c_ahashtable_ptr_t PlanOperation::getResultHashTable(size_t index) cons
   return output.getHashTable(index);
 }
 
+hash_table_list_t PlanOperation::getResultHashTables() const {
+  return output.getHashTables();
+}
+
 bool PlanOperation::allDependenciesSuccessful() {
   for (size_t i = 0; i < _dependencies.size(); ++i) {
     if (std::dynamic_pointer_cast<OutputTask>(_dependencies[i])->getState() == OpFail) return false;
@@ -164,11 +193,15 @@ void PlanOperation::setErrorMessage(const std::string& message) {
 }
 
 void PlanOperation::operator()() noexcept {
-  if (allDependenciesSuccessful()) {
+  // Tasks of a cancelled query fail without being executed, the
+  // ResponseTask reports the cancellation once
+  if (allDependenciesSuccessful() && !(_cancellation && _cancellation->isCancelled())) {
     try {
       LOG4CXX_DEBUG(logger, "Executing " << vname() << "(" << _operatorId << ")");
       execute();
       return;
+    } catch (const QueryCancelledException &ex) {
+      LOG4CXX_DEBUG(logger, planOperationName() << " (" << _operatorId << ") " << ex.what());
     } catch (const std::exception &ex) {
       setErrorMessage(ex.what());
     } catch (...) {
@@ -181,10 +214,8 @@ void PlanOperation::operator()() noexcept {
 const PlanOperation * PlanOperation::execute() {
   const bool recordPerformance = _performance_attr != nullptr;
 
-  // Check if we really need this
-  epoch_t startTime;
-  if (recordPerformance)
-    startTime = get_epoch_nanoseconds();
+  // task times are measured for the cost models of dynamic parallelization
+  const epoch_t startTime = get_epoch_nanoseconds();
 
   PapiTracer pt;
 
@@ -204,8 +235,11 @@ const PlanOperation * PlanOperation::execute() {
 
   teardownPlanOperation();
 
+  const epoch_t endTime = get_epoch_nanoseconds();
+  if (_costObservation)
+    _costObservation->taskDone(endTime - startTime);
+
   if (recordPerformance) {
-    epoch_t endTime = get_epoch_nanoseconds();
     std::string threadId = boost::lexical_cast<std::string>(std::this_thread::get_id());
     *_performance_attr = (performance_attributes_t) {
       pt.value("PAPI_TOT_CYC"), pt.value(getEvent()), getEvent() , planOperationName(), _operatorId, startTime, endTime, threadId
@@ -232,6 +266,10 @@ void PlanOperation::addInput(storage::c_aresource_ptr_t t) {
   input.addResource(t);
 }
 
+void PlanOperation::setCancellationToken(const std::shared_ptr<CancellationToken>& token) {
+  _cancellation = token;
+}
+
 void PlanOperation::setPlanId(std::string i) {
   _planId = i;
 }
@@ -4,6 +4,7 @@
 
 #include "access/system/OutputTask.h"
 #include "access/system/OperationData.h"
+#include "access/system/QueryCancellation.h"
 #include "access/system/QueryParser.h"
 #include "io/TXContext.h"
 
@@ -18,6 +19,7 @@ namespace hyrise {
 namespace access {
 
 class ResponseTask;
+class CostObservation;
 
 /**
  * This is the default interface for a plan operation. Our basic assumption is
@@ -45,6 +47,17 @@ class PlanOperation : public OutputTask {
   /* Returns all errors of dependencies as one concatenated std::string */
   std::string getDependencyErrorMessages();
 
+  /* Cancellation point, throws a QueryCancelledException if the query
+     was cancelled or exceeded its deadline. Long loops call it every
+     cancellationCheckInterval rows. */
+  void checkCancellation() {
+    if (_cancellation) {
+      _cancellation->check();
+    }
+  }
+
+  static const size_t cancellationCheckInterval = 1024;
+
 
   /* 
    * The model used is based on a/x + b as an equation, whereas x
@@ -61,10 +74,15 @@ class PlanOperation : public OutputTask {
   virtual double calcA(double totalTblSizeIn100k);
   /*
    * The standard implementation of the calc* method assume
-   * a straight line model with a*x + b.
-   * You can either override the following parameters in your operator
-   * or you can supply your calc* methods.
+   * a model with a = a_a * aTerm(size) + a_b and
+   * b = min_mts_a * minMtsTerm(size) + min_mts_b, both straight lines
+   * by default. The parameters are learned from the measured task times
+   * on this host (see CostModel); the following offline fit is used
+   * until enough tasks were measured. You can override the parameters
+   * and terms in your operator.
    */
+  virtual double aTerm(double totalTblSizeIn100k) { return totalTblSizeIn100k; }
+  virtual double minMtsTerm(double totalTblSizeIn100k) { return totalTblSizeIn100k; }
   virtual double min_mts_a() { return 0; }
   virtual double min_mts_b() { return 0; }
   virtual double a_a() { return 0; }
@@ -74,18 +92,25 @@ class PlanOperation : public OutputTask {
   virtual ~PlanOperation();
 
   virtual size_t determineDynamicCount(size_t maxTaskRunTime);
+  /// Measures the instances for the cost model of this operation
+  virtual void notifyParallelized(const std::vector<taskscheduler::task_ptr_t>& instances, size_t dynamicCount);
 
   void setLimit(uint64_t l);
   void setProducesPositions(bool p);
   
   void setTXContext(tx::TXContext ctx);
 
+  /// Whether the operation writes within its transaction, plans without
+  /// such operations may run as read-only snapshot
+  virtual bool isModifying() const { return false; }
+
   void addInput(storage::c_aresource_ptr_t t);
 
   const storage::c_atable_ptr_t getInputTable(size_t index = 0) const;
   const storage::c_atable_ptr_t getResultTable(size_t index = 0) const;
   storage::c_ahashtable_ptr_t getInputHashTable(size_t index = 0) const;
   storage::c_ahashtable_ptr_t getResultHashTable(size_t index = 0) const;
+  hash_table_list_t getResultHashTables() const;
 
   void addField(field_t field);
   void addField(const Json::Value &field);
@@ -100,6 +125,8 @@ class PlanOperation : public OutputTask {
   virtual const std::string vname();
   const PlanOperation *execute();
 
+  void setCancellationToken(const std::shared_ptr<CancellationToken>& token);
+
   void setErrorMessage(const std::string& message);
   void setResponseTask(const std::shared_ptr<ResponseTask>& responseTask);
   std::shared_ptr<ResponseTask> getResponseTask() const;
@@ -128,6 +155,12 @@ class PlanOperation : public OutputTask {
   
   tx::TXContext _txContext;
 
+  std::shared_ptr<CancellationToken> _cancellation;
+
+  /// Input size determineDynamicCount used, 0 if it did not
+  double _dynamicTableSize = 0;
+  std::shared_ptr<CostObservation> _costObservation;
+
 };
 
 
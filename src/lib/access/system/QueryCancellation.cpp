@@ -0,0 +1,67 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/QueryCancellation.h"
+
+namespace hyrise {
+namespace access {
+
+void CancellationToken::cancel(const std::string &reason) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_cancelled.load()) {
+    _reason = reason;
+    _cancelled.store(true);
+  }
+}
+
+std::string CancellationToken::reason() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _reason;
+}
+
+RunningQueries &RunningQueries::getInstance() {
+  static RunningQueries queries;
+  return queries;
+}
+
+void RunningQueries::add(const std::string &queryId, const std::shared_ptr<CancellationToken> &token) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _queries.insert(std::make_pair(queryId, token));
+}
+
+void RunningQueries::remove(const std::string &queryId, const std::shared_ptr<CancellationToken> &token) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto range = _queries.equal_range(queryId);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == token) {
+      _queries.erase(it);
+      return;
+    }
+  }
+}
+
+size_t RunningQueries::cancel(const std::string &queryId, const std::string &reason) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto range = _queries.equal_range(queryId);
+  size_t cancelled = 0;
+  for (auto it = range.first; it != range.second; ++it, ++cancelled) {
+    it->second->cancel(reason);
+  }
+  return cancelled;
+}
+
+void RunningQueries::setDefaultDeadline(std::chrono::milliseconds deadline) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _defaultDeadline = deadline;
+}
+
+std::chrono::milliseconds RunningQueries::getDefaultDeadline() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _defaultDeadline;
+}
+
+size_t RunningQueries::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _queries.size();
+}
+
+}
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_QUERYCANCELLATION_H_
+#define SRC_LIB_ACCESS_QUERYCANCELLATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace hyrise {
+namespace access {
+
+class QueryCancelledException : public std::runtime_error {
+ public:
+  explicit QueryCancelledException(const std::string &what) : std::runtime_error(what) {}
+};
+
+/*
+ * Cancellation state shared by all plan operations of one query. A
+ * query is cancelled explicitly (see RunningQueries) or once its
+ * deadline passed. Plan operations check it before they start and at
+ * cancellation points in long loops, see PlanOperation::checkCancellation.
+ */
+class CancellationToken {
+ public:
+  typedef std::chrono::steady_clock clock_t;
+
+  CancellationToken() {}
+  explicit CancellationToken(clock_t::time_point deadline) : _deadline(deadline), _hasDeadline(true) {}
+
+  bool isCancelled() {
+    if (_cancelled.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    if (_hasDeadline && clock_t::now() >= _deadline) {
+      cancel("deadline exceeded");
+      return true;
+    }
+    return false;
+  }
+
+  // Throws a QueryCancelledException if the query is cancelled
+  void check() {
+    if (isCancelled()) {
+      throw QueryCancelledException("Query cancelled: " + reason());
+    }
+  }
+
+  void cancel(const std::string &reason);
+
+  std::string reason() const;
+
+ private:
+  std::atomic<bool> _cancelled {false};
+  clock_t::time_point _deadline;
+  bool _hasDeadline = false;
+
+  mutable std::mutex _mutex;
+  std::string _reason;
+};
+
+/*
+ * Server wide registry of the running queries by query id, used by the
+ * /cancel/ handler. Queries are registered by RequestParseTask and
+ * removed by their ResponseTask.
+ */
+class RunningQueries {
+ public:
+  static RunningQueries &getInstance();
+
+  void add(const std::string &queryId, const std::shared_ptr<CancellationToken> &token);
+  void remove(const std::string &queryId, const std::shared_ptr<CancellationToken> &token);
+
+  //  Cancels all running queries with queryId, returns their number
+  size_t cancel(const std::string &queryId, const std::string &reason = "cancelled by request");
+
+  size_t size() const;
+
+  //  Deadline of queries that do not specify one, 0 is none
+  void setDefaultDeadline(std::chrono::milliseconds deadline);
+  std::chrono::milliseconds getDefaultDeadline() const;
+
+ private:
+  RunningQueries() {}
+
+  mutable std::mutex _mutex;
+  std::chrono::milliseconds _defaultDeadline {0};
+  std::unordered_multimap<std::string, std::shared_ptr<CancellationToken> > _queries;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_QUERYCANCELLATION_H_
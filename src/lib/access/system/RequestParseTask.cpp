@@ -1,7 +1,10 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/system/RequestParseTask.h"
 
+#include <algorithm>
+#include <atomic>
 #include <array>
+#include <cctype>
 #include <iomanip>
 #include <map>
 #include <string>
@@ -11,10 +14,15 @@
 
 #include "boost/lexical_cast.hpp"
 
+#include "access/system/AdmissionControl.h"
 #include "access/system/ResponseTask.h"
+#include "access/system/PlanCache.h"
 #include "access/system/PlanOperation.h"
+#include "access/system/QueryCancellation.h"
 #include "access/system/QueryTransformationEngine.h"
+#include "access/system/ResultCursors.h"
 #include "access/tx/Commit.h"
+#include "access/tx/ValidatePositions.h"
 
 #include "helper/epoch.h"
 #include "helper/HttpHelper.h"
@@ -56,6 +64,50 @@ log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.access"));
 log4cxx::LoggerPtr _query_logger(log4cxx::Logger::getLogger("hyrise.access.queries"));
 }
 
+namespace {
+const std::array<const char *, 14> requestOptions = {{
+    "session_context", "autocommit", "performance", "format", "limit", "offset", "plan", "prepare",
+    "cursor", "cursor_ttl", "close", "query_id", "deadline", "read_only" }};
+
+// Numbers the query ids of read-only snapshots
+std::atomic<size_t> readOnlyQueries(0);
+
+bool isJsonRequest(const net::AbstractConnection &connection) {
+  const std::string contentType = connection.getHeader("Content-Type");
+  return contentType.compare(0, 16, "application/json") == 0;
+}
+}
+
+std::map<std::string, std::string> jsonRequestOptions(const Json::Value &body,
+                                                      const net::AbstractConnection &connection) {
+  std::map<std::string, std::string> options;
+  for (const std::string option : requestOptions) {
+    const Json::Value &value = body[option];
+    if (value.isString()) {
+      options[option] = value.asString();
+    } else if (value.isBool()) {
+      options[option] = value.asBool() ? "true" : "false";
+    } else if (value.isIntegral()) {
+      options[option] = std::to_string(value.asLargestInt());
+    } else {
+      // Canonical header name, "session_context" is "X-Hyrise-Session-Context"
+      std::string header = "X-Hyrise-" + option;
+      for (size_t i = 9; i < header.size(); ++i) {
+        if (header[i] == '_') {
+          header[i] = '-';
+        } else if (header[i - 1] == '-') {
+          header[i] = toupper(header[i]);
+        }
+      }
+      const std::string headerValue = connection.getHeader(header);
+      if (!headerValue.empty()) {
+        options[option] = headerValue;
+      }
+    }
+  }
+  return options;
+}
+
 std::string hash(const std::string &v) {
   const std::string& jsonData = v;
 
@@ -81,29 +133,100 @@ void RequestParseTask::operator()() {
   int sessionId = 0;
 
   if (_connection->hasBody()) {
-    // The body is a wellformed HTTP Post body, with key value pairs
     std::string body(_connection->getBody());
-    std::map<std::string, std::string> body_data = parseHTTPFormData(body);
+    std::map<std::string, std::string> body_data;
+
+    Json::Value request_data;
+    Json::Value parameters;
+    Json::Reader reader;
+    std::string parse_error;
+    // The plan id of the query
+    std::string query_string;
+
+    const bool json_request = isJsonRequest(*_connection);
+    if (json_request) {
+      // The body is the query itself or an object with the query in
+      // "query" and the request options as further fields
+      Json::Value json_body;
+      if (!reader.parse(body, json_body, false)) {
+        parse_error = reader.getFormatedErrorMessages();
+      } else if (!json_body.isObject()) {
+        parse_error = "Request body is no JSON object";
+      } else {
+        body_data = jsonRequestOptions(json_body, *_connection);
+        parameters = json_body.get("parameters", Json::Value(Json::objectValue));
+        // Swapped instead of copied, plans may be large
+        request_data.swap(json_body.isMember("query") ? json_body["query"] : json_body);
+      }
+      query_string = std::move(body);
+    } else {
+      // The body is a wellformed HTTP Post body, with key value pairs
+      body_data = parseHTTPFormData(body);
+      for (auto& option : body_data) {
+        option.second = urldecode(option.second);
+      }
+      query_string = body_data["query"];
+    }
+
+    // "cursor=open" keeps the result as cursor, "cursor=<id>" fetches a
+    // page of a kept result without executing a plan
+    auto cursor_it = body_data.find("cursor");
+    const bool open_cursor = cursor_it != body_data.end() && cursor_it->second == "open";
+    const bool fetch_cursor = cursor_it != body_data.end() && !open_cursor;
 
     tx::TXContext ctx;
     auto ctx_it = body_data.find("session_context");
-    if (ctx_it != body_data.end()) {
+    const bool new_transaction = !fetch_cursor && ctx_it == body_data.end();
+    if (fetch_cursor) {
+      // The result of the cursor already is a snapshot
+    } else if (ctx_it != body_data.end()) {
       std::size_t pos;
       tx::transaction_id_t tid = std::stoll(ctx_it->second.c_str(), &pos);
       tx::transaction_id_t cid = std::stoll(ctx_it->second.c_str() + pos + 1, &pos);
       ctx = tx::TXContext(tid, cid);
-    } else {
-      ctx = tx::TransactionManager::beginTransaction();
-      LOG4CXX_DEBUG(_logger, "Creating new transaction context " << ctx.tid);
+    }
+    // New transactions are begun once the plan is known, see below
+
+    // A prepared plan is executed by handle ("plan") with the values of its
+    // parameters, a query is registered as prepared plan with "prepare"
+    auto plan_it = body_data.find("plan");
+    auto prepare_it = body_data.find("prepare");
+    const bool prepared = plan_it != body_data.end();
+    const bool prepare = !prepared && prepare_it != body_data.end();
+
+    if (!parse_error.empty() || fetch_cursor) {
+      // The json request body could not be parsed or there is no plan
+    } else if (prepared) {
+      const std::string& handle = plan_it->second;
+      if (!json_request && !reader.parse(getOrDefault(body_data, "parameters", "{}"), parameters)) {
+        parse_error = reader.getFormatedErrorMessages();
+      } else if (auto plan = PlanCache::getInstance().get(handle)) {
+        try {
+          request_data = plan->bind(parameters);
+        } catch (const std::exception &ex) {
+          parse_error = ex.what();
+        }
+      } else {
+        parse_error = "No prepared plan " + handle;
+      }
+    } else if (!json_request && !reader.parse(query_string, request_data)) {
+      parse_error = reader.getFormatedErrorMessages();
     }
 
-    Json::Value request_data;
-    Json::Reader reader;
-
-    const std::string& query_string = urldecode(body_data["query"]);
-
-    if (reader.parse(query_string, request_data)) {
-      _responseTask->setTxContext(ctx);
+    if (fetch_cursor && parse_error.empty()) {
+      if (const auto& result = ResultCursors::getInstance().fetch(cursor_it->second)) {
+        _responseTask->setCursorResult(result);
+      } else {
+        _responseTask->addErrorMessage("No cursor " + cursor_it->second);
+      }
+      if (getOrDefault(body_data, "close", "false") == "true") {
+        ResultCursors::getInstance().close(cursor_it->second);
+      }
+    } else if (parse_error.empty()) {
+      if (open_cursor) {
+        const size_t ttl = atol(getOrDefault(body_data, "cursor_ttl", "0").c_str());
+        _responseTask->setOpenCursor(ttl > 0 ? ttl : ResultCursors::defaultTimeToLive);
+      }
       recordPerformance = getOrDefault(body_data, "performance", "false") == "true";
       _responseTask->setRecordPerformanceData(recordPerformance);
 
@@ -114,7 +237,7 @@ void RequestParseTask::operator()() {
 
       LOG4CXX_DEBUG(_query_logger, request_data);
 
-      const std::string& final_hash = hash(query_string);
+      const std::string& final_hash = hash(prepared ? plan_it->second : query_string);
       std::shared_ptr<Task> result = nullptr;
 
       if(request_data.isMember("priority"))
@@ -125,9 +248,15 @@ void RequestParseTask::operator()() {
       _responseTask->setSessionId(sessionId);
       _responseTask->setRecordPerformanceData(recordPerformance);
       try {
-        tasks = QueryParser::instance().deserialize(
-                  QueryTransformationEngine::getInstance()->transform(request_data),
-                  &result);
+        if (prepare) {
+          PlanCache::getInstance().add(prepare_it->second,
+                                       QueryTransformationEngine::getInstance()->transform(request_data));
+        } else {
+          // Prepared plans are stored after the transformation
+          tasks = QueryParser::instance().deserialize(
+                    prepared ? request_data : QueryTransformationEngine::getInstance()->transform(request_data),
+                    &result);
+        }
 
       } catch (const std::exception &ex) {
         // clean up, so we don't end up with a whole mess due to thrown exceptions
@@ -138,8 +267,44 @@ void RequestParseTask::operator()() {
         result = nullptr;
       }
 
-      auto autocommit_it = body_data.find("autocommit");
-      if (autocommit_it != body_data.end() && (autocommit_it->second == "true")) {
+      const bool autocommit = getOrDefault(body_data, "autocommit", "false") == "true";
+      if (new_transaction) {
+        // Queries run as read-only snapshot with "read_only=true" and when
+        // they are autocommitted without modifying operators, as such
+        // transactions cannot be continued with a session context
+        const std::string read_only = getOrDefault(body_data, "read_only", "");
+        const auto modifying = std::find_if(tasks.begin(), tasks.end(), [] (const std::shared_ptr<Task>& task) {
+            auto op = std::dynamic_pointer_cast<PlanOperation>(task);
+            return op && op->isModifying();
+          });
+        const bool modifies = modifying != tasks.end();
+        if (read_only == "true" && modifies) {
+          _responseTask->addErrorMessage("RequestParseTask: read-only query contains modifying operation " +
+                                         std::dynamic_pointer_cast<PlanOperation>(*modifying)->planOperationName());
+          tasks.clear();
+          result = nullptr;
+        }
+        if (read_only == "true" || (read_only.empty() && autocommit && !modifies)) {
+          ctx = tx::TransactionManager::beginReadOnlyTransaction();
+        } else if (!prepare) {
+          // The snapshot is pinned for plans reading under MVCC and for
+          // transactions that are continued and may read later on
+          const bool reads = std::any_of(tasks.begin(), tasks.end(), [] (const std::shared_ptr<Task>& task) {
+              return std::dynamic_pointer_cast<ValidatePositions>(task) != nullptr;
+            });
+          ctx = tx::TransactionManager::beginTransaction(reads || !autocommit);
+          LOG4CXX_DEBUG(_logger, "Creating new transaction context " << ctx.tid);
+        }
+      }
+      if (new_transaction && ctx.isReadOnly()) {
+        _responseTask->setSnapshot(ctx);
+      } else if (new_transaction && !prepare) {
+        _responseTask->setNewTransaction(ctx);
+      } else {
+        _responseTask->setTxContext(ctx);
+      }
+
+      if (!prepare && autocommit && !ctx.isReadOnly()) {
         auto commit = std::make_shared<Commit>();
         commit->setOperatorId("__autocommit");
         commit->setPlanOperationName("Commit");
@@ -152,14 +317,28 @@ void RequestParseTask::operator()() {
 
       if (result != nullptr) {
         _responseTask->addDependency(result);
-      } else {
+      } else if (!prepare) {
         LOG4CXX_ERROR(_logger, "Json did not yield tasks");
       }
 
+      if (!prepare) {
+        // The query id for /cancel/ is the transaction id unless the client
+        // chose one, read-only snapshots share their transaction id
+        const std::string queryId = getOrDefault(body_data, "query_id", ctx.isReadOnly()
+            ? "snapshot-" + std::to_string(++readOnlyQueries) : std::to_string(ctx.tid));
+        const size_t deadline = atol(getOrDefault(body_data, "deadline", "0").c_str());
+        const auto timeout = (deadline > 0) ? std::chrono::milliseconds(deadline)
+                                            : RunningQueries::getInstance().getDefaultDeadline();
+        _responseTask->setCancellation(queryId, (timeout.count() > 0)
+            ? std::make_shared<CancellationToken>(CancellationToken::clock_t::now() + timeout)
+            : std::make_shared<CancellationToken>());
+      }
+
       for (const auto & func: tasks) {
         if (auto task = std::dynamic_pointer_cast<PlanOperation>(func)) {
           task->setPriority(priority);
           task->setSessionId(sessionId);
+          task->setQueryId(_responseTask->getQueryId());
           task->setPlanId(final_hash);
           task->setTXContext(ctx);
           task->setId(ctx.tid);
@@ -175,13 +354,14 @@ void RequestParseTask::operator()() {
       }
     } else {
       LOG4CXX_ERROR(_logger, "Failed to parse: "
-                    << urldecode(body_data["query"]) << "\n"
-                    << body_data["query"] << "\n"
-                    << reader.getFormatedErrorMessages());
+                    << query_string << "\n"
+                    << parse_error);
 
       // Forward parsing error
-      _responseTask->addErrorMessage("Parsing: " + reader.getFormatedErrorMessages());      
+      _responseTask->addErrorMessage("Parsing: " + parse_error);
     }
+    _responseTask->setBinaryResponse(getOrDefault(body_data, "format", "json") == "binary");
+
     // Update the transmission limit for the response task
     if (atoi(body_data["limit"].c_str()) > 0)
       _responseTask->setTransmitLimit(atol(body_data["limit"].c_str()));
@@ -220,15 +400,25 @@ void RequestParseTask::operator()() {
     _responseTask.reset();  // yield responsibility
 
   } else {
-    scheduler->schedule(_responseTask);
-    scheduler->scheduleQuery(tasks);
-
     if (recordPerformance) {
       *(performance_data.at(0)) = { 0, 0, "NO_PAPI", "RequestParseTask", "requestParse", 
                                     _queryStart, get_epoch_nanoseconds(), 
                                     boost::lexical_cast<std::string>(std::this_thread::get_id()) };
     }
     _responseTask->setQueryStart(_queryStart);
+
+    // The plan is scheduled once it is admitted, possibly after other queries finished
+    auto responseTask = _responseTask;
+    AdmissionControl::getInstance().admit(
+        priority, sessionId, tasks.size(),
+        [scheduler, responseTask, tasks] (std::unique_ptr<AdmissionTicket> ticket) {
+          responseTask->setAdmissionTicket(std::move(ticket));
+          scheduler->schedule(responseTask);
+          scheduler->scheduleQuery(tasks);
+        },
+        [responseTask] (const std::string &message) {
+          responseTask->reject(message);
+        });
     _responseTask.reset();  // yield responsibility
   }
 }
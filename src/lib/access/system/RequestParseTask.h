@@ -2,9 +2,12 @@
 #ifndef SRC_LIB_ACCESS_REQUESTPARSETASK_H_
 #define SRC_LIB_ACCESS_REQUESTPARSETASK_H_
 
+#include <map>
 #include <string>
 #include <memory>
 
+#include <json.h>
+
 #include "helper/epoch.h"
 #include "net/Router.h"
 #include "net/AbstractConnection.h"
@@ -14,6 +17,13 @@ namespace access {
 
 class ResponseTask;
 
+/// Returns the options (session_context, autocommit, limit, ...) of a
+/// request with an application/json body. They are read from the
+/// top-level fields of the body, or else from the X-Hyrise-* request
+/// headers, e.g. X-Hyrise-Session-Context.
+std::map<std::string, std::string> jsonRequestOptions(const Json::Value &body,
+                                                      const net::AbstractConnection &connection);
+
 class RequestParseTask : public net::AbstractRequestHandler {
  private:
   net::AbstractConnection *_connection;
@@ -1,16 +1,21 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/system/ResponseTask.h"
 
+#include <algorithm>
 #include <thread>
+#include <utility>
 
 #include "json.h"
 #include "log4cxx/logger.h"
 #include "boost/lexical_cast.hpp"
 
+#include "access/system/BinaryResponse.h"
 #include "access/system/PlanOperation.h"
+#include "access/system/ResultCursors.h"
 #include "access/system/OutputTask.h"
 #include "io/TransactionManager.h"
 #include "helper/PapiTracer.h"
+#include "taskscheduler/SharedScheduler.h"
 
 #include "net/AsyncConnection.h"
 
@@ -24,6 +29,11 @@ namespace access {
 
 namespace {
 log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.net"));
+
+// Results with more rows are sent with chunked transfer encoding,
+// serializing and sending streamingBatchSize rows at a time
+const size_t streamingRowThreshold = 16384;
+const size_t streamingBatchSize = 1024;
 }
 
 template <typename T>
@@ -42,21 +52,20 @@ struct json_functor {
   }
 };
 
+// Returns the rows [first, stop) of a table with the given limit and offset
+std::pair<size_t, size_t> transmittedRows(const storage::c_atable_ptr_t& table,
+                                          const size_t transmitLimit, const size_t transmitOffset) {
+  const size_t first = std::min(transmitOffset, table->size());
+  const size_t stop = (transmitLimit > 0) ? std::min(table->size(), transmitOffset + transmitLimit) : table->size();
+  return {first, stop};
+}
+
 template<typename T>
-Json::Value generateRowsJsonT(const T& table, const size_t transmitLimit, const size_t transmitOffset) {
+Json::Value generateRowsJsonT(const T& table, const size_t first, const size_t stop) {
   storage::type_switch<hyrise_basic_types> ts;
   json_functor<T> fun(table);
   Json::Value rows(Json::arrayValue);
-  for (size_t row = 0; row < table->size(); ++row) {
-
-    // Align offset
-    if (row < transmitOffset)
-      continue;
-
-    // Break if limit reached
-    if (transmitLimit > 0 && row == (transmitOffset + transmitLimit))
-      break;
-
+  for (size_t row = first; row < stop; ++row) {
     fun.row = row;
     Json::Value json_row(Json::arrayValue);
     for (size_t col = 0; col < table->columnCount(); ++col) {
@@ -70,14 +79,81 @@ Json::Value generateRowsJsonT(const T& table, const size_t transmitLimit, const
 }
 
 Json::Value generateRowsJson(const std::shared_ptr<const storage::AbstractTable>& table,
-                             const size_t transmitLimit, const size_t transmitOffset) {
+                             const size_t first, const size_t stop) {
   if (const auto& store = std::dynamic_pointer_cast<const storage::SimpleStore>(table)) {
-    return generateRowsJsonT(store, transmitLimit, transmitOffset);
+    return generateRowsJsonT(store, first, stop);
   } else {
-    return generateRowsJsonT(table, transmitLimit, transmitOffset);
+    return generateRowsJsonT(table, first, stop);
+  }
+}
+
+namespace {
+
+// Rows [first, stop) of table followed by the members of the serialized
+// response json, sent as one JSON object in chunks
+struct RowStream {
+  net::AbstractConnection *connection;
+  storage::c_atable_ptr_t table;
+  size_t first;
+  size_t next;
+  size_t stop;
+  std::string json;
+  // of the ResponseTask, continuations are scheduled like it
+  int priority;
+  int sessionId;
+  std::string queryId;
+};
+
+void continueRowStream(const std::shared_ptr<RowStream>& stream);
+
+class RowStreamTask : public taskscheduler::Task {
+ public:
+  explicit RowStreamTask(std::shared_ptr<RowStream> stream) : _stream(std::move(stream)) {
+    setPriority(_stream->priority);
+    setSessionId(_stream->sessionId);
+    setQueryId(_stream->queryId);
+  }
+
+  virtual void operator()() {
+    continueRowStream(_stream);
   }
+
+  const std::string vname() {
+    return "RowStreamTask";
+  }
+
+ private:
+  std::shared_ptr<RowStream> _stream;
+};
+
+// Sends batches while the client keeps up, otherwise the worker is given
+// back and a RowStreamTask continues once the client caught up
+void continueRowStream(const std::shared_ptr<RowStream>& stream) {
+  Json::FastWriter fw;
+  auto connection = stream->connection;
+  while (stream->next < stream->stop) {
+    if (!connection->isWritable()) {
+      connection->whenWritable([stream] () {
+          taskscheduler::SharedScheduler::getInstance().getScheduler()->schedule(std::make_shared<RowStreamTask>(stream));
+        });
+      return;
+    }
+    const size_t batch = stream->next;
+    stream->next = std::min(stream->stop, batch + streamingBatchSize);
+    std::string rows = fw.write(generateRowsJson(stream->table, batch, stream->next));
+    // Strip "[" and "]\n" of the batch array, batches are joined by commas
+    rows = rows.substr(1, rows.size() - 3);
+    if (batch > stream->first) {
+      rows.insert(0, ",");
+    }
+    connection->writeChunk(rows);
+  }
+  connection->writeChunk("]," + stream->json.substr(1));
+  connection->endChunkedResponse();
 }
 
+}  // namespace
+
 const std::string ResponseTask::vname() {
   return "ResponseTask";
 }
@@ -92,6 +168,7 @@ void ResponseTask::registerPlanOperation(const std::shared_ptr<PlanOperation>& p
   }
   
   planOp->setGeneratedKeysData(genKeys);
+  planOp->setCancellationToken(_cancellation);
 
   const auto responseTaskPtr = std::dynamic_pointer_cast<ResponseTask>(shared_from_this());
   planOp->setResponseTask(responseTaskPtr);
@@ -124,21 +201,65 @@ task_states_t ResponseTask::getState() const {
   return OpSuccess;
 }
 
+ResponseTask::~ResponseTask() {
+  if (_ownsSnapshot) {
+    tx::TransactionManager::commitTransaction(_txContext);
+  }
+}
+
+void ResponseTask::setCancellation(const std::string &queryId, const std::shared_ptr<CancellationToken> &token) {
+  setQueryId(queryId);
+  _cancellation = token;
+  RunningQueries::getInstance().add(queryId, token);
+}
+
+void ResponseTask::unregisterQuery() {
+  if (_cancellation) {
+    RunningQueries::getInstance().remove(_queryId, _cancellation);
+  }
+}
+
+void ResponseTask::rollbackNewTransaction() {
+  if (!_ownsTransaction) {
+    return;
+  }
+  _ownsTransaction = false;
+  try {
+    tx::TransactionManager::rollbackTransaction(_txContext);
+  } catch (const std::exception &e) {
+    LOG4CXX_ERROR(_logger, "Rolling back transaction " << _txContext.tid << " failed: " << e.what());
+  }
+}
+
+void ResponseTask::reject(const std::string &message) {
+  unregisterQuery();
+  // The plan and its commit never run, a continued transaction is left
+  // to its client
+  rollbackNewTransaction();
+
+  Json::Value response;
+  response["error"].append(Json::Value(message));
+  Json::FastWriter fw;
+  connection->respond(fw.write(response));
+}
+
 void ResponseTask::operator()() {
   epoch_t responseStart = _recordPerformanceData ? get_epoch_nanoseconds() : 0;
   Json::Value response;
+  storage::c_atable_ptr_t binaryResult;
+  storage::c_atable_ptr_t streamedResult;
 
-  if (getDependencyCount() > 0) {
+  if (getDependencyCount() > 0 || _cursorResult) {
     PapiTracer pt;
     pt.addEvent("PAPI_TOT_CYC");
 
     if(_recordPerformanceData) pt.start();
 
-    auto predecessor = getResultTask();
-    const auto& result = predecessor->getResultTable();
+    const auto result = _cursorResult ? _cursorResult : getResultTask()->getResultTable();
 
     if (getState() != OpFail) {
-      if (!_isAutoCommit) {
+      // Read-only snapshots cannot be continued
+      if (!_isAutoCommit && !_cursorResult && !_txContext.isReadOnly()) {
         response["session_context"] = std::to_string(_txContext.tid).append(" ").append(std::to_string(_txContext.lastCid));
       }
 
@@ -152,7 +273,22 @@ void ResponseTask::operator()() {
 
         // Copy the complete result
         response["real_size"] = result->size();
-        response["rows"] = generateRowsJson(result, _transmitLimit, _transmitOffset);
+        if (_openCursor) {
+          try {
+            response["cursor"] = ResultCursors::getInstance().open(result, _txContext, _cursorTimeToLive);
+          } catch (const std::exception &e) {
+            addErrorMessage(e.what());
+          }
+        }
+        const auto rows = transmittedRows(result, _transmitLimit, _transmitOffset);
+        if (_binaryResponse) {
+          binaryResult = result;
+        } else if (rows.second - rows.first > streamingRowThreshold) {
+          // The rows are written while sending, see below
+          streamedResult = result;
+        } else {
+          response["rows"] = generateRowsJson(result, rows.first, rows.second);
+        }
         response["header"] = json_header;
       }
 
@@ -203,6 +339,19 @@ void ResponseTask::operator()() {
     LOG4CXX_DEBUG(_logger, "Table Use Count: " << result.use_count());
   }
 
+  unregisterQuery();
+  // Abandoned cursors keep their snapshots pinned until released here
+  ResultCursors::getInstance().expire();
+  const bool failed = getState() == OpFail;
+  if (_cancellation && failed && _cancellation->isCancelled()) {
+    addErrorMessage("Query cancelled: " + _cancellation->reason());
+  }
+  // Failed, cancelled and unparseable requests do not return their
+  // context, nobody else ends their transaction
+  if (failed || getDependencyCount() == 0) {
+    rollbackNewTransaction();
+  }
+
   if (!_error_messages.empty()) {
     Json::Value errors;
     for (const auto& msg: _error_messages) {
@@ -212,8 +361,32 @@ void ResponseTask::operator()() {
   }
 
   LOG4CXX_DEBUG(_logger, response);
+  _admissionTicket.reset();
+
+  if (_binaryResponse) {
+    connection->respond(generateBinaryResponse(binaryResult, response, _transmitLimit, _transmitOffset),
+                        200, binaryResponseContentType);
+    return;
+  }
 
   Json::FastWriter fw;
+  if (streamedResult) {
+    const auto rows = transmittedRows(streamedResult, _transmitLimit, _transmitOffset);
+    auto stream = std::make_shared<RowStream>();
+    stream->connection = connection;
+    stream->table = streamedResult;
+    stream->first = rows.first;
+    stream->next = rows.first;
+    stream->stop = rows.second;
+    stream->json = fw.write(response);
+    stream->priority = getPriority();
+    stream->sessionId = getSessionId();
+    stream->queryId = getQueryId();
+    connection->beginChunkedResponse();
+    connection->writeChunk("{\"rows\":[");
+    continueRowStream(stream);
+    return;
+  }
   connection->respond(fw.write(response));
 }
 
@@ -6,9 +6,12 @@
 #include <mutex>
 
 #include "helper/epoch.h"
+#include "access/system/AdmissionControl.h"
+#include "access/system/QueryCancellation.h"
 #include "access/system/OutputTask.h"
 #include "net/AbstractConnection.h"
 #include "io/TXContext.h"
+#include "storage/storage_types.h"
 
 namespace hyrise {
 namespace access {
@@ -26,6 +29,25 @@ class ResponseTask : public taskscheduler::Task {
   tx::TXContext _txContext;
   epoch_t queryStart = 0;
   bool _isAutoCommit = false;
+  // Read-only snapshot of the context, released when the task is destroyed
+  bool _ownsSnapshot = false;
+  // Transaction begun for this request, rolled back if the request fails
+  bool _ownsTransaction = false;
+  bool _binaryResponse = false;
+  // Keep the result as cursor, see ResultCursors.h
+  bool _openCursor = false;
+  size_t _cursorTimeToLive = 0;
+  // Result of a cursor that is fetched instead of a query result
+  storage::c_atable_ptr_t _cursorResult;
+  // Released once the result is serialized
+  std::unique_ptr<AdmissionTicket> _admissionTicket;
+  // Shared with all plan operations, see registerPlanOperation
+  std::shared_ptr<CancellationToken> _cancellation;
+
+  // Removes the query from RunningQueries
+  void unregisterQuery();
+  // Rolls back the transaction begun for this request, see setNewTransaction
+  void rollbackNewTransaction();
   performance_vector_t performance_data;
 
   // Unique refs to the generated keys of all planops
@@ -43,7 +65,7 @@ class ResponseTask : public taskscheduler::Task {
         _affectedRows = 0;
   }
 
-  virtual ~ResponseTask() {}
+  virtual ~ResponseTask();
 
   const std::string vname();
 
@@ -66,11 +88,51 @@ class ResponseTask : public taskscheduler::Task {
   void setIsAutoCommit(bool b) {
     _isAutoCommit = b;
   }
+
+  // Respond in the binary columnar format of BinaryResponse.h
+  void setBinaryResponse(bool b) {
+    _binaryResponse = b;
+  }
   
+  void setOpenCursor(size_t timeToLive) {
+    _openCursor = true;
+    _cursorTimeToLive = timeToLive;
+  }
+
+  void setCursorResult(const storage::c_atable_ptr_t &result) {
+    _cursorResult = result;
+  }
+
+  // Registers the query in RunningQueries, has to be set before the
+  // plan operations are registered
+  void setCancellation(const std::string &queryId, const std::shared_ptr<CancellationToken> &token);
+
+  void setAdmissionTicket(std::unique_ptr<AdmissionTicket> ticket) {
+    _admissionTicket = std::move(ticket);
+  }
+
+  // Responds with message as error instead of a result, the plan is not
+  // executed and a transaction begun for the request is rolled back
+  void reject(const std::string &message);
+
   void setTxContext(tx::TXContext t) {
     _txContext = t;
   }
 
+  // Takes over a read-only snapshot context, it stays pinned until the
+  // task is destroyed, as streamed results are read while sending
+  void setSnapshot(tx::TXContext t) {
+    _txContext = t;
+    _ownsSnapshot = true;
+  }
+
+  // Takes over a transaction begun for this request. It is rolled back
+  // if the request fails, as the client does not get its context then.
+  void setNewTransaction(tx::TXContext t) {
+    _txContext = t;
+    _ownsTransaction = true;
+  }
+
   tx::TXContext getTxContext() const {
     return _txContext;
   }
@@ -0,0 +1,120 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ResultCursors.h"
+
+#include <random>
+#include <stdexcept>
+
+#include "io/TransactionManager.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace access {
+
+const size_t ResultCursors::defaultTimeToLive;
+const size_t ResultCursors::defaultMaxCursors;
+
+ResultCursors &ResultCursors::getInstance() {
+  static ResultCursors cursors;
+  return cursors;
+}
+
+std::string ResultCursors::open(const storage::c_atable_ptr_t &result, const tx::TXContext &ctx,
+                                size_t timeToLive) {
+  // The random part keeps clients from guessing the cursors of others
+  static thread_local std::mt19937_64 generator(std::random_device{}());
+  const auto now = clock_t::now();
+
+  std::string id;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    expire(now);
+    if (_maxCursors > 0 && _cursors.size() >= _maxCursors) {
+      throw std::runtime_error("Too many open cursors (" + std::to_string(_maxCursors) + ")");
+    }
+    // Pinned before the visible rows are read, so they are not collected meanwhile
+    tx::TransactionManager::getInstance().pinReadOnlySnapshot(ctx.lastCid);
+    id = std::to_string(++_nextId) + "-" + std::to_string(generator());
+    _cursors[id] = {result, ctx.lastCid, std::chrono::seconds(timeToLive), now + std::chrono::seconds(timeToLive)};
+    _nextExpiry = std::min(_nextExpiry.load(), _cursors[id].expires);
+  }
+
+  if (const auto& store = std::dynamic_pointer_cast<const storage::Store>(result)) {
+    const auto snapshot = std::make_shared<storage::PointerCalculator>(result, store->buildValidPositions(ctx.lastCid, ctx.tid));
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _cursors.find(id);
+    if (it != _cursors.end()) {
+      it->second.result = snapshot;
+    }
+  }
+  return id;
+}
+
+storage::c_atable_ptr_t ResultCursors::fetch(const std::string &id) {
+  const auto now = clock_t::now();
+  std::lock_guard<std::mutex> lock(_mutex);
+  expire(now);
+  auto it = _cursors.find(id);
+  if (it == _cursors.end()) {
+    return nullptr;
+  }
+  it->second.expires = now + it->second.timeToLive;
+  return it->second.result;
+}
+
+bool ResultCursors::close(const std::string &id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _cursors.find(id);
+  if (it == _cursors.end()) {
+    return false;
+  }
+  release(it);
+  return true;
+}
+
+void ResultCursors::expire() {
+  const auto now = clock_t::now();
+  if (now < _nextExpiry.load()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  expire(now);
+}
+
+size_t ResultCursors::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _cursors.size();
+}
+
+void ResultCursors::setMaxCursors(size_t maxCursors) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _maxCursors = maxCursors;
+}
+
+void ResultCursors::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto it = _cursors.begin(); it != _cursors.end();) {
+    it = release(it);
+  }
+}
+
+void ResultCursors::expire(clock_t::time_point now) {
+  auto next = clock_t::time_point::max();
+  for (auto it = _cursors.begin(); it != _cursors.end();) {
+    if (it->second.expires <= now) {
+      it = release(it);
+    } else {
+      next = std::min(next, it->second.expires);
+      ++it;
+    }
+  }
+  _nextExpiry = next;
+}
+
+ResultCursors::cursor_map_t::iterator ResultCursors::release(cursor_map_t::iterator it) {
+  tx::TransactionManager::getInstance().unpinReadOnlySnapshot(it->second.snapshot);
+  return _cursors.erase(it);
+}
+
+}
+}
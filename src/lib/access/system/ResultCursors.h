@@ -0,0 +1,86 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_RESULTCURSORS_H_
+#define SRC_LIB_ACCESS_RESULTCURSORS_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "io/TXContext.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Server wide registry of query results that are fetched page by page.
+ * A query opened with "cursor=open" keeps its result under a cursor id,
+ * later requests with "cursor=<id>" send further pages (limit and
+ * offset) of that result without executing the plan again. A cursor
+ * pins the snapshot of its query until it is closed or expires, which
+ * it does if it is not fetched for its time to live. Opening more than
+ * the maximum number of cursors fails.
+ */
+class ResultCursors {
+ public:
+  typedef std::chrono::steady_clock clock_t;
+
+  static const size_t defaultTimeToLive = 60;  // seconds
+  static const size_t defaultMaxCursors = 1024;
+
+  static ResultCursors &getInstance();
+
+  /*  Keeps result under a new cursor id and returns the id. A Store is
+      replaced by its rows visible to ctx, so later fetches read the same
+      snapshot. Results of scans are position lists that already are.
+      Throws if the maximum number of cursors is open or the snapshot of
+      ctx cannot be pinned anymore.  */
+  std::string open(const storage::c_atable_ptr_t &result, const tx::TXContext &ctx,
+                   size_t timeToLive = defaultTimeToLive);
+
+  //  Returns the result of cursor id and renews its time to live, nullptr
+  //  if there is no such cursor or it expired
+  storage::c_atable_ptr_t fetch(const std::string &id);
+
+  bool close(const std::string &id);
+
+  //  Releases the cursors that expired, cheap while none did
+  void expire();
+
+  size_t size() const;
+
+  //  Zero allows any number of open cursors
+  void setMaxCursors(size_t maxCursors);
+
+  void clear();
+
+ private:
+  ResultCursors() {}
+
+  struct Cursor {
+    storage::c_atable_ptr_t result;
+    tx::transaction_cid_t snapshot;
+    std::chrono::seconds timeToLive;
+    clock_t::time_point expires;
+  };
+  typedef std::unordered_map<std::string, Cursor> cursor_map_t;
+
+  // Removes expired cursors, the mutex has to be held
+  void expire(clock_t::time_point now);
+  // Unpins the snapshot of a cursor and removes it, the mutex has to be held
+  cursor_map_t::iterator release(cursor_map_t::iterator it);
+
+  mutable std::mutex _mutex;
+  size_t _nextId = 0;
+  size_t _maxCursors = defaultMaxCursors;
+  // No cursor expires before, read without the mutex
+  std::atomic<clock_t::time_point> _nextExpiry{clock_t::time_point::max()};
+  cursor_map_t _cursors;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_RESULTCURSORS_H_
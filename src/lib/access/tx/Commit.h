@@ -12,6 +12,8 @@ public:
 
 	void executePlanOperation();
 
+	bool isModifying() const { return true; }
+
 	static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
 
 
@@ -8,6 +8,8 @@ namespace access {
 
 class Rollback : public PlanOperation {
   void executePlanOperation();
+ public:
+  bool isModifying() const { return true; }
 };
 
 }
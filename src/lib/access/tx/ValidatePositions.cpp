@@ -18,6 +18,7 @@ namespace {
 
 void ValidatePositions::executePlanOperation() {
   LOG4CXX_DEBUG(logger, "Validating Positions with: " << _txContext.tid << "(tid) and " << _txContext.lastCid << "(lCID)");
+  tx::TransactionManager::getInstance().pinSnapshot(_txContext);
 
   // Allow to operate directly on the store
   if (std::dynamic_pointer_cast<const storage::Store>(getInputTable(0))) {
@@ -34,10 +35,12 @@ void ValidatePositions::executePlanOperation() {
     auto pc = std::const_pointer_cast<storage::PointerCalculator>(tab);
     pc->validate(_txContext.tid, _txContext.lastCid);
 
-    // Get Modifications
-    const auto& modifications = tx::TransactionManager::getInstance()[_txContext.tid];
-    if (modifications.hasDeleted(store))
-      pc->remove(modifications.getDeleted(store));
+    // Get Modifications, transactions that did not modify anything
+    // (e.g. read-only snapshots) are not registered
+    if (auto modifications = tx::TransactionManager::getInstance().getModifications(_txContext.tid)) {
+      if ((*modifications).hasDeleted(store))
+        pc->remove((*modifications).getDeleted(store));
+    }
     addResult(getInputTable(0));
   }
 
@@ -0,0 +1,83 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/EpochReclamation.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace hyrise { namespace locking {
+
+// Reader slot of the current thread, released when the thread exits
+struct ThreadSlot {
+  size_t index = EpochReclamation::maxThreads;
+  size_t depth = 0;
+
+  ~ThreadSlot() {
+    if (index != EpochReclamation::maxThreads) {
+      EpochReclamation::getInstance().releaseSlot(index);
+    }
+  }
+};
+
+namespace {
+thread_local ThreadSlot threadSlot;
+}
+
+EpochReclamation::EpochReclamation() : _epoch(1), _slotLimit(0) {}
+
+EpochReclamation &EpochReclamation::getInstance() {
+  static EpochReclamation domain;
+  return domain;
+}
+
+size_t EpochReclamation::acquireSlot() {
+  for (size_t i = 0; i < maxThreads; ++i) {
+    bool expected = false;
+    if (!_slots[i].used.load() && _slots[i].used.compare_exchange_strong(expected, true)) {
+      size_t limit = _slotLimit.load();
+      while (limit <= i && !_slotLimit.compare_exchange_weak(limit, i + 1)) {}
+      return i;
+    }
+  }
+  throw std::runtime_error("EpochReclamation: more than " + std::to_string(maxThreads) + " reader threads");
+}
+
+void EpochReclamation::releaseSlot(size_t slot) {
+  _slots[slot].epoch.store(0);
+  _slots[slot].used.store(false);
+}
+
+EpochReclamation::Guard::Guard() {
+  auto &domain = getInstance();
+  if (threadSlot.index == maxThreads) {
+    threadSlot.index = domain.acquireSlot();
+  }
+  if (threadSlot.depth++ == 0) {
+    // Sequentially consistent, so the structure is read after the pinned
+    // epoch became visible to writers, see isReclaimable
+    domain._slots[threadSlot.index].epoch.store(domain._epoch.load());
+  }
+}
+
+EpochReclamation::Guard::~Guard() {
+  if (--threadSlot.depth == 0) {
+    getInstance()._slots[threadSlot.index].epoch.store(0);
+  }
+}
+
+EpochReclamation::epoch_t EpochReclamation::retire() {
+  return _epoch.fetch_add(1);
+}
+
+bool EpochReclamation::isReclaimable(epoch_t epoch) const {
+  // Readers that pinned a later epoch entered after the object was
+  // unlinked and cannot reach it
+  for (size_t i = 0, limit = _slotLimit.load(); i < limit; ++i) {
+    const epoch_t pinned = _slots[i].epoch.load();
+    if (pinned != 0 && pinned <= epoch) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}}
@@ -0,0 +1,65 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hyrise { namespace locking {
+
+/*
+ * Epoch-based reclamation for structures that are read without locks.
+ * Readers pin the current epoch with a Guard while they may hold
+ * pointers into the structure. A writer that unlinks an object calls
+ * retire(), which returns the epoch of the removal, and may reuse or
+ * free the object once isReclaimable(epoch) holds, i.e. once every
+ * reader that could still see it has left its Guard.
+ *
+ * Every thread uses one reader slot, it is taken on the first Guard and
+ * given back when the thread exits. Guards may be nested.
+ */
+class EpochReclamation {
+ public:
+  typedef uint64_t epoch_t;
+
+  static const size_t maxThreads = 1024;
+
+  class Guard {
+   public:
+    Guard();
+    ~Guard();
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+  };
+
+  static EpochReclamation &getInstance();
+
+  /// Called after an object was unlinked, returns its retire epoch
+  epoch_t retire();
+
+  /// Whether objects retired in `epoch` are not visible to any reader
+  bool isReclaimable(epoch_t epoch) const;
+
+  EpochReclamation(const EpochReclamation&) = delete;
+  EpochReclamation& operator=(const EpochReclamation&) = delete;
+
+ private:
+  friend struct ThreadSlot;
+
+  struct alignas(64) Slot {
+    std::atomic<epoch_t> epoch {0};
+    std::atomic<bool> used {false};
+  };
+
+  EpochReclamation();
+
+  size_t acquireSlot();
+  void releaseSlot(size_t slot);
+
+  std::atomic<epoch_t> _epoch;
+  Slot _slots[maxThreads];
+  // Slots at or behind this index were never used
+  std::atomic<size_t> _slotLimit;
+};
+
+}}
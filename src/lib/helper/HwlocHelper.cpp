@@ -12,6 +12,10 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 int getNumberOfCoresOnSystem(){
   hwloc_topology_t topology = getHWTopology();
@@ -73,3 +77,28 @@ unsigned getNumberOfCoresPerNumaNode(){
   number_of_nodes = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
   return number_of_cores/number_of_nodes;
 };
+
+bool bindThreadToCore(hwloc_thread_t thread, unsigned core){
+  hwloc_topology_t topology = getHWTopology();
+  hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE, core);
+  if (obj == nullptr) {
+    fprintf(stderr, "Couldn't bind to core %u: no such core\n", core);
+    return false;
+  }
+  // the bitmap to modify
+  hwloc_cpuset_t cpuset = hwloc_bitmap_dup(obj->cpuset);
+  // remove hyperthreads
+  hwloc_bitmap_singlify(cpuset);
+  bool bound = true;
+  if (hwloc_set_thread_cpubind(topology, thread, cpuset, HWLOC_CPUBIND_STRICT | HWLOC_CPUBIND_NOMEMBIND)) {
+    char *str;
+    int error = errno;
+    hwloc_bitmap_asprintf(&str, obj->cpuset);
+    fprintf(stderr, "Couldn't bind to cpuset %s: %s\n", str, strerror(error));
+    fprintf(stderr, "Continuing as normal, however, no guarantees\n");
+    free(str);
+    bound = false;
+  }
+  hwloc_bitmap_free(cpuset);
+  return bound;
+}
@@ -17,4 +17,6 @@ hwloc_topology_t getHWTopology();
 std::vector<unsigned> getCoresForNode(hwloc_topology_t topology, unsigned node);
 unsigned getNumberOfNodes(hwloc_topology_t topology);
 unsigned getNumberOfCoresPerNumaNode();
+// binds thread to the core without hyperthreads, returns false if binding failed
+bool bindThreadToCore(hwloc_thread_t thread, unsigned core);
 
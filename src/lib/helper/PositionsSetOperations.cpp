@@ -0,0 +1,261 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/PositionsSetOperations.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace hyrise { namespace helper {
+
+using storage::pos_t;
+using storage::pos_list_t;
+
+const size_t parallelSetOperationThreshold = 1 << 22;
+const size_t gallopingRatio = 32;
+
+namespace {
+
+// Minimum number of positions handled by one thread
+const size_t minPartitionSize = 1 << 18;
+
+// Returns the first element in [first, last) not smaller than value by
+// probing exponentially growing distances before doing a binary search
+const pos_t* gallop(const pos_t* first, const pos_t* last, pos_t value) {
+  const pos_t* lo = first;
+  const pos_t* hi = first;
+  size_t step = 1;
+  while (hi < last && *hi < value) {
+    lo = hi + 1;
+    hi = (static_cast<size_t>(last - hi) > step) ? hi + step : last;
+    step <<= 1;
+  }
+  return std::lower_bound(lo, hi, value);
+}
+
+// Number of leading positions in [first, first + size) smaller than value
+size_t count_smaller(const pos_t* first, size_t size, pos_t value) {
+  size_t k = 0;
+#if defined(__AVX2__)
+  // positions are below 2^63, so the signed comparison is safe
+  const __m256i v = _mm256_set1_epi64x(static_cast<long long>(value));
+  for (; k + 4 <= size; k += 4) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + k));
+    const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, block)));
+    if (mask != 0xF) return k + __builtin_ctz(~mask);
+  }
+#elif defined(__SSE4_2__)
+  const __m128i v = _mm_set1_epi64x(static_cast<long long>(value));
+  for (; k + 2 <= size; k += 2) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + k));
+    const int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(v, block)));
+    if (mask != 0x3) return k + __builtin_ctz(~mask);
+  }
+#endif
+  for (; k < size; ++k) {
+    if (first[k] >= value) return k;
+  }
+  return size;
+}
+
+void intersect_scalar(const pos_t* a, size_t na, const pos_t* b, size_t nb, pos_list_t& result) {
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      result.push_back(a[i]);
+      ++i;
+      ++j;
+    }
+  }
+}
+
+// Compares blocks of positions of both inputs all-against-all and advances
+// the block with the smaller maximum, see Schlegel et al., Fast
+// Sorted-Set Intersection using SIMD Instructions, ADMS 2011
+void intersect_simd(const pos_t* a, size_t na, const pos_t* b, size_t nb, pos_list_t& result) {
+  size_t i = 0, j = 0;
+#if defined(__AVX2__)
+  while (i + 4 <= na && j + 4 <= nb) {
+    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i cmp = _mm256_cmpeq_epi64(va, vb);
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+    for (int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp)); mask; mask &= mask - 1) {
+      result.push_back(a[i + __builtin_ctz(mask)]);
+    }
+    const pos_t a_max = a[i + 3], b_max = b[j + 3];
+    if (a_max <= b_max) i += 4;
+    if (b_max <= a_max) j += 4;
+  }
+#elif defined(__SSE4_1__)
+  while (i + 2 <= na && j + 2 <= nb) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    const __m128i cmp = _mm_or_si128(_mm_cmpeq_epi64(va, vb),
+                                     _mm_cmpeq_epi64(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    for (int mask = _mm_movemask_pd(_mm_castsi128_pd(cmp)); mask; mask &= mask - 1) {
+      result.push_back(a[i + __builtin_ctz(mask)]);
+    }
+    const pos_t a_max = a[i + 1], b_max = b[j + 1];
+    if (a_max <= b_max) i += 2;
+    if (b_max <= a_max) j += 2;
+  }
+#endif
+  intersect_scalar(a + i, na - i, b + j, nb - j, result);
+}
+
+void intersect_galloping(const pos_t* small, size_t ns, const pos_t* large, size_t nl, pos_list_t& result) {
+  const pos_t* it = large;
+  const pos_t* end = large + nl;
+  for (size_t i = 0; i < ns && it != end; ++i) {
+    it = gallop(it, end, small[i]);
+    if (it != end && *it == small[i]) {
+      result.push_back(small[i]);
+      ++it;
+    }
+  }
+}
+
+// Branch free merge that copies whole runs of positions smaller than the
+// head of the other input, which are found with SIMD comparisons
+void unite_merge(const pos_t* a, size_t na, const pos_t* b, size_t nb, pos_list_t& result) {
+  const size_t block = 8;
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    if (i + block <= na && a[i + block - 1] < b[j]) {
+      const size_t run = block + count_smaller(a + i + block, na - i - block, b[j]);
+      result.insert(result.end(), a + i, a + i + run);
+      i += run;
+      continue;
+    }
+    if (j + block <= nb && b[j + block - 1] < a[i]) {
+      const size_t run = block + count_smaller(b + j + block, nb - j - block, a[i]);
+      result.insert(result.end(), b + j, b + j + run);
+      j += run;
+      continue;
+    }
+    const pos_t x = a[i], y = b[j];
+    result.push_back(x < y ? x : y);
+    i += x <= y;
+    j += y <= x;
+  }
+  result.insert(result.end(), a + i, a + na);
+  result.insert(result.end(), b + j, b + nb);
+}
+
+void unite_galloping(const pos_t* small, size_t ns, const pos_t* large, size_t nl, pos_list_t& result) {
+  const pos_t* it = large;
+  const pos_t* end = large + nl;
+  for (size_t i = 0; i < ns; ++i) {
+    const pos_t* next = gallop(it, end, small[i]);
+    result.insert(result.end(), it, next);
+    it = next;
+    result.push_back(small[i]);
+    if (it != end && *it == small[i]) ++it;
+  }
+  result.insert(result.end(), it, end);
+}
+
+typedef void (*kernel_t)(const pos_t*, size_t, const pos_t*, size_t, pos_list_t&);
+
+size_t partitionCount(size_t total) {
+  if (total < parallelSetOperationThreshold) return 1;
+  const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  return std::max<size_t>(1, std::min(threads, total / minPartitionSize));
+}
+
+// Splits both inputs into value ranges at equidistant positions of the
+// larger input and applies the kernel to each pair of ranges in parallel
+void apply_partitioned(const pos_list_t& left, const pos_list_t& right, pos_list_t& result,
+                       kernel_t kernel, bool unite) {
+  const auto& large = left.size() >= right.size() ? left : right;
+  const auto& small = left.size() >= right.size() ? right : left;
+  const size_t partitions = partitionCount(left.size() + right.size());
+
+  result.clear();
+  if (partitions == 1) {
+    result.reserve(unite ? left.size() + right.size() : small.size());
+    kernel(left.data(), left.size(), right.data(), right.size(), result);
+    return;
+  }
+
+  std::vector<size_t> large_bounds(partitions + 1), small_bounds(partitions + 1);
+  for (size_t p = 0; p < partitions; ++p) {
+    large_bounds[p] = p * large.size() / partitions;
+    small_bounds[p] = (p == 0) ? 0 : std::lower_bound(small.begin(), small.end(), large[large_bounds[p]]) - small.begin();
+  }
+  large_bounds[partitions] = large.size();
+  small_bounds[partitions] = small.size();
+
+  std::vector<pos_list_t> parts(partitions);
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < partitions; ++p) {
+    threads.emplace_back([&, p] () {
+      const size_t nl = large_bounds[p + 1] - large_bounds[p];
+      const size_t ns = small_bounds[p + 1] - small_bounds[p];
+      parts[p].reserve(unite ? nl + ns : std::min(nl, ns));
+      kernel(large.data() + large_bounds[p], nl, small.data() + small_bounds[p], ns, parts[p]);
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  size_t total = 0;
+  for (const auto& part : parts) total += part.size();
+  result.reserve(total);
+  for (auto& part : parts) {
+    result.insert(result.end(), part.begin(), part.end());
+    pos_list_t().swap(part);
+  }
+}
+
+void intersect_kernel(const pos_t* left, size_t left_size, const pos_t* right, size_t right_size, pos_list_t& result) {
+  if (left_size == 0 || right_size == 0) return;
+  if (left_size > right_size) {
+    std::swap(left, right);
+    std::swap(left_size, right_size);
+  }
+  // disjoint value ranges
+  if (left[left_size - 1] < right[0] || right[right_size - 1] < left[0]) return;
+
+  if (right_size / left_size >= gallopingRatio) {
+    intersect_galloping(left, left_size, right, right_size, result);
+  } else {
+    intersect_simd(left, left_size, right, right_size, result);
+  }
+}
+
+void unite_kernel(const pos_t* left, size_t left_size, const pos_t* right, size_t right_size, pos_list_t& result) {
+  if (left_size > right_size) {
+    std::swap(left, right);
+    std::swap(left_size, right_size);
+  }
+  if (left_size == 0) {
+    result.insert(result.end(), right, right + right_size);
+  } else if (right_size / left_size >= gallopingRatio) {
+    unite_galloping(left, left_size, right, right_size, result);
+  } else {
+    unite_merge(left, left_size, right, right_size, result);
+  }
+}
+
+}
+
+void intersect_sorted(const pos_list_t& left, const pos_list_t& right, pos_list_t& result) {
+  apply_partitioned(left, right, result, &intersect_kernel, false);
+}
+
+void unite_sorted(const pos_list_t& left, const pos_list_t& right, pos_list_t& result) {
+  apply_partitioned(left, right, result, &unite_kernel, true);
+}
+
+} } // namespace hyrise::helper
+
@@ -0,0 +1,30 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstddef>
+
+#include "helper/types.h"
+
+namespace hyrise { namespace helper {
+
+/*
+ * Set operations on sorted, duplicate free position lists.
+ *
+ * Depending on the input sizes the kernels gallop through the larger list
+ * (skewed sizes), compare blocks of positions with SIMD instructions
+ * (similar sizes, AVX2 or SSE4.1 when available) or split the inputs into
+ * value ranges that are processed by multiple threads (very large inputs).
+ */
+
+// Inputs with more positions in total are processed in parallel
+extern const size_t parallelSetOperationThreshold;
+
+// Size ratio from which on the larger list is searched by galloping
+extern const size_t gallopingRatio;
+
+// Both replace the content of result
+void intersect_sorted(const storage::pos_list_t& left, const storage::pos_list_t& right, storage::pos_list_t& result);
+void unite_sorted(const storage::pos_list_t& left, const storage::pos_list_t& right, storage::pos_list_t& result);
+
+} } // namespace hyrise::helper
+
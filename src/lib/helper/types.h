@@ -30,6 +30,9 @@ static const transaction_id_t MERGE_TID = 1;
 	// the merge needs its own TID so that it is isolated from the other transactions
 static const transaction_id_t START_TID = 2;
 static const transaction_id_t MAX_TID = std::numeric_limits<transaction_id_t>::max();
+static const transaction_id_t READ_ONLY_TID = MAX_TID;
+	// read-only snapshot transactions share this TID, it is never assigned
+	// to a row, so they only see committed rows
 
 static const transaction_id_t UNKNOWN = 0;
 static const transaction_cid_t UNKNOWN_CID = 0;
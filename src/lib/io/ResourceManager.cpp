@@ -65,6 +65,17 @@ std::shared_ptr<storage::AbstractResource> ResourceManager::getResource(const st
   return _resources.at(name);
 }
 
+bool ResourceManager::useExclusively(const std::string& name,
+                                     const std::function<void(const std::shared_ptr<storage::AbstractResource>&)>& fn) const {
+  auto lock = lock_guard(_resource_mutex);
+  auto it = _resources.find(name);
+  if (it == _resources.end() || it->second.use_count() != 1) {
+    return false;
+  }
+  fn(it->second);
+  return true;
+}
+
 ResourceManager::resource_map ResourceManager::all() const {
   auto lock = lock_guard(_resource_mutex);
   return _resources;
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -58,6 +59,12 @@ class ResourceManager {
     return checked_pointer_cast<T>(getResource(name));
   }
 
+  /// Calls fn with the resource if nothing but the resource manager
+  /// references it. The resource cannot be retrieved until fn returns.
+  /// @returns whether fn was called
+  bool useExclusively(const std::string& name,
+                      const std::function<void(const std::shared_ptr<storage::AbstractResource>&)>& fn) const;
+
   /// Removes a named resource
   void remove(const std::string& name) const;
 
@@ -18,6 +18,9 @@ struct TXContext {
   TXContext(id_t _tid, id_t _lastCid, id_t _cid = UNKNOWN):
       tid(_tid), lastCid(_lastCid), cid(_cid) {}
 
+  /// Read-only snapshot, see TransactionManager::beginReadOnlyTransaction
+  bool isReadOnly() const { return tid == READ_ONLY_TID; }
+
   template<class Archive>
   void serialize(Archive & archive) {
     archive(cereal::make_nvp("transaction_id", tid),
@@ -6,7 +6,6 @@
 #include <map>
 
 #include "optional.hpp"
-#include "helper/make_unique.h"
 #include "helper/checked_cast.h"
 #include "helper/vector_helpers.h"
 #include "storage/Store.h"
@@ -14,9 +13,21 @@
 namespace hyrise {
 namespace tx {
 
+namespace {
+locking::Spinlock _insertMtx;
+}
+
 void TXModifications::insertPos(const storage::c_atable_ptr_t& tab, pos_t pos) {
-  static locking::Spinlock _mtx;
-  _handle(_mtx, inserted, tab, pos);
+  _handle(_insertMtx, inserted, tab, pos);
+}
+
+void TXModifications::insertPosRange(const storage::c_atable_ptr_t& tab, pos_t first, size_t count) {
+  std::lock_guard<locking::Spinlock> lck(_insertMtx);
+  auto& positions = inserted[tab];
+  positions.reserve(positions.size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    positions.push_back(first + i);
+  }
 }
 
 void TXModifications::deletePos(const storage::c_atable_ptr_t& tab, pos_t pos) {
@@ -63,7 +74,8 @@ TransactionManager& TransactionManager::getInstance() {
 }
 
 transaction_id_t TransactionManager::getTransactionId() {
-  if (_transactionCount == std::numeric_limits<transaction_id_t>::max()) {
+  // The last id is READ_ONLY_TID
+  if (_transactionCount >= READ_ONLY_TID - 1) {
     throw std::runtime_error("Out of transaction ids - reached maximum");
   }
 
@@ -74,8 +86,115 @@ transaction_cid_t TransactionManager::getLastCommitId() {
   return _commitId;
 }
 
-TXContext TransactionManager::buildContext() {
-  return {getTransactionId(), getLastCommitId()};
+TXContext TransactionManager::buildContext(bool pin) {
+  const transaction_id_t tid = getTransactionId();
+  if (!pin) {
+    return {tid, getLastCommitId()};
+  }
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  return {tid, pinLastCommit(tid)};
+}
+
+transaction_cid_t TransactionManager::pinLastCommit(transaction_id_t tid) {
+  // The commit id is read under the lock, so getOldestActiveSnapshot
+  // never misses a snapshot older than the commit id it read before
+  const transaction_cid_t lastCid = getLastCommitId();
+  ++_snapshots[lastCid];
+  if (tid != READ_ONLY_TID) {
+    _pinnedSnapshots[tid] = {lastCid, std::chrono::steady_clock::now()};
+  }
+  return lastCid;
+}
+
+void TransactionManager::pinSnapshot(const TXContext& ctx) {
+  if (ctx.isReadOnly()) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  auto pinned = _pinnedSnapshots.find(ctx.tid);
+  if (pinned != _pinnedSnapshots.end()) {
+    pinned->second.lastRead = now;
+    return;
+  }
+  // The collector may have removed rows deleted after the snapshot
+  if (ctx.lastCid < _collectedSnapshot) {
+    throw std::runtime_error("Snapshot " + std::to_string(ctx.lastCid) + " of transaction " +
+                             std::to_string(ctx.tid) + " is too old, roll back and retry");
+  }
+  ++_snapshots[ctx.lastCid];
+  _pinnedSnapshots[ctx.tid] = {ctx.lastCid, now};
+}
+
+void TransactionManager::setSnapshotTimeout(std::chrono::steady_clock::duration timeout) {
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  _snapshotTimeout = timeout;
+}
+
+void TransactionManager::unpinSnapshot(transaction_id_t tid) {
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  auto pinned = _pinnedSnapshots.find(tid);
+  if (pinned == _pinnedSnapshots.end()) {
+    return;
+  }
+  auto it = _snapshots.find(pinned->second.lastCid);
+  if (--it->second == 0) {
+    _snapshots.erase(it);
+  }
+  _pinnedSnapshots.erase(pinned);
+}
+
+void TransactionManager::pinReadOnlySnapshot(transaction_cid_t lastCid) {
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  if (lastCid < _collectedSnapshot) {
+    throw std::runtime_error("Snapshot " + std::to_string(lastCid) + " is too old");
+  }
+  ++_snapshots[lastCid];
+}
+
+void TransactionManager::unpinReadOnlySnapshot(transaction_cid_t lastCid) {
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  auto it = _snapshots.find(lastCid);
+  if (it != _snapshots.end() && --it->second == 0) {
+    _snapshots.erase(it);
+  }
+}
+
+transaction_cid_t TransactionManager::getOldestActiveSnapshot() {
+  const transaction_cid_t lastCid = getLastCommitId();
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  // Transactions of dropped sessions never end, their pins expire
+  if (_snapshotTimeout > std::chrono::steady_clock::duration::zero()) {
+    for (auto pinned = _pinnedSnapshots.begin(); pinned != _pinnedSnapshots.end();) {
+      if (now - pinned->second.lastRead < _snapshotTimeout) {
+        ++pinned;
+        continue;
+      }
+      auto it = _snapshots.find(pinned->second.lastCid);
+      if (--it->second == 0) {
+        _snapshots.erase(it);
+      }
+      pinned = _pinnedSnapshots.erase(pinned);
+    }
+  }
+  const transaction_cid_t oldest = _snapshots.empty() ? lastCid : std::min(lastCid, _snapshots.begin()->first);
+  _collectedSnapshot = std::max(_collectedSnapshot, oldest);
+  return oldest;
+}
+
+bool TransactionManager::isRunning(transaction_id_t tid) const {
+  return _txData.find(tid) != nullptr;
+}
+
+bool TransactionManager::hasRunningTransactions() const {
+  bool running = false;
+  _txData.forEach([&running] (const TransactionData&) { running = true; });
+  return running;
+}
+
+std::unique_lock<locking::Spinlock> TransactionManager::blockCommits() {
+  return std::unique_lock<locking::Spinlock>(_txLock);
 }
 
 transaction_cid_t TransactionManager::prepareCommit() {
@@ -98,22 +217,17 @@ transaction_cid_t TransactionManager::tryPrepareCommit() {
 }
 
 TXModifications& TransactionManager::operator[](const transaction_id_t& key) {
-  return _txData([&key] (map_t& txData) -> TXModifications& {
-      if (txData.find(key) == txData.end()) {
-        txData[key] = make_unique<TransactionData>();
-      }
-      return txData[key]->_modifications;
-    });
+  if (key == READ_ONLY_TID) {
+    throw std::runtime_error("Read-only transactions cannot modify tables");
+  }
+  return _txData.getOrCreate(key)._modifications;
 }
 
 std::optional<const TXModifications&> TransactionManager::getModifications(const transaction_id_t key) const {
-  return _txData([&key] (const map_t& txData) -> std::optional<const TXModifications&> {
-      auto it = txData.find(key);
-      if (it == txData.end()) {
-        return std::nullopt;
-      }
-      return it->second->_modifications;
-    });
+  if (auto data = _txData.find(key)) {
+    return std::optional<const TXModifications&>(data->_modifications);
+  }
+  return std::nullopt;
 }
 
 
@@ -130,21 +244,29 @@ void TransactionManager::commit(transaction_id_t tid) {
 void TransactionManager::reset() {
   _transactionCount = START_TID;
   _commitId = UNKNOWN_CID;
-  _txData([] (map_t& txData) { txData.clear(); });
+  _txData.clear();
+  std::lock_guard<locking::Spinlock> lock(_snapshotLock);
+  _snapshots.clear();
+  _pinnedSnapshots.clear();
+  _collectedSnapshot = UNKNOWN_CID;
+}
+
+TXContext TransactionManager::beginTransaction(bool pin) {
+  return getInstance().buildContext(pin);
 }
 
-TXContext TransactionManager::beginTransaction() {
-  return getInstance().buildContext();
+TXContext TransactionManager::beginReadOnlyTransaction() {
+  auto& txmgr = getInstance();
+  std::lock_guard<locking::Spinlock> lock(txmgr._snapshotLock);
+  return {READ_ONLY_TID, txmgr.pinLastCommit(READ_ONLY_TID)};
 }
 
 std::vector<TXContext> TransactionManager::getCurrentModifyingTransactionContexts() {
-  return getInstance()._txData([] (const map_t& data) {
-      std::vector<TXContext> result;
-      for(const auto& kv: data) {
-        result.push_back(kv.second->_context);
-      }
-      return result;
+  std::vector<TXContext> result;
+  getInstance()._txData.forEach([&result] (const TransactionData& data) {
+      result.push_back(data._context);
     });
+  return result;
 }
 
 
@@ -159,12 +281,15 @@ storage::store_ptr_t getStore(const storage::c_atable_ptr_t& table) {
 
 void TransactionManager::endTransaction(transaction_id_t tid) {
   // Clear all relevant data for this transaction
-  _txData([&tid] (map_t& txData) {
-      txData.erase(tid);
-    });
+  _txData.erase(tid);
+  unpinSnapshot(tid);
 }
 
 void TransactionManager::rollbackTransaction(TXContext ctx) {
+  if (ctx.isReadOnly()) {
+    getInstance().unpinReadOnlySnapshot(ctx.lastCid);
+    return;
+  }
   // unmark positions previously marked for delete
   // auto& txData = getTransactionData(ctx.tid);
   for(auto& kv : getInstance()[ctx.tid].deleted) {
@@ -175,47 +300,103 @@ void TransactionManager::rollbackTransaction(TXContext ctx) {
   getInstance().endTransaction(ctx.tid);
 }
 
+transaction_cid_t TransactionManager::joinCommitGroup(bool& leader) {
+  transaction_cid_t cid = UNKNOWN_CID;
+  std::unique_lock<std::mutex> lock(_groupMutex);
+  _pendingCommits.push_back(&cid);
+  _groupAssigned.wait(lock, [&] { return cid != UNKNOWN_CID || !_groupLeader; });
+  if (cid != UNKNOWN_CID) {
+    leader = false;
+    return cid;
+  }
+
+  // Lead all committers waiting by now, including those arriving while
+  // the prepare commit lock is taken
+  leader = true;
+  _groupLeader = true;
+  lock.unlock();
+  _txLock.lock();
+  transaction_cid_t next = getLastCommitId();
+  lock.lock();
+  for (auto slot : _pendingCommits) {
+    *slot = ++next;
+  }
+  _unfinishedCommits = _pendingCommits.size();
+  _groupLastCid = next;
+  _pendingCommits.clear();
+  _groupAssigned.notify_all();
+  return cid;
+}
+
+void TransactionManager::leaveCommitGroup(transaction_cid_t cid, bool leader) {
+  std::unique_lock<std::mutex> lock(_groupMutex);
+  --_unfinishedCommits;
+  if (!leader) {
+    if (_unfinishedCommits == 0) {
+      _groupFinished.notify_all();
+    }
+    _groupFinished.wait(lock, [&] { return getLastCommitId() >= cid; });
+    return;
+  }
+
+  _groupFinished.wait(lock, [&] { return _unfinishedCommits == 0; });
+  _commitId = _groupLastCid;
+  _txLock.unlock();
+  _groupLeader = false;
+  _groupFinished.notify_all();
+  // Committers that arrived meanwhile elect the next leader
+  _groupAssigned.notify_all();
+}
+
 transaction_cid_t TransactionManager::commitTransaction(TXContext ctx) {
   auto& txmgr = getInstance();
-  ctx.cid = txmgr.prepareCommit();
-  if (auto mods = txmgr.getModifications(ctx.tid)) {
-    const auto& modifications = *mods;
-    // Only update the required positions
-    for (auto& kv: modifications.deleted) {
-      auto weak_table = kv.first;
-      // Only deleted records have to be checked for validity as newly inserted
-      // records will be always only written by us
-      if (auto store = getStore(weak_table.lock())) {
+  if (ctx.isReadOnly()) {
+    txmgr.unpinReadOnlySnapshot(ctx.lastCid);
+    return ctx.lastCid;
+  }
+  auto mods = txmgr.getModifications(ctx.tid);
+  if (mods) {
+    // Only deleted records have to be checked for validity as newly inserted
+    // records will be always only written by us. Rows marked for deletion
+    // cannot be taken over by other transactions, so this needs no lock.
+    for (auto& kv: (*mods).deleted) {
+      if (auto store = getStore(kv.first.lock())) {
         if (TX_CODE::TX_OK != store->checkForConcurrentCommit(kv.second, ctx.tid)) {
-          txmgr.abort();
           throw std::runtime_error("Aborted TX with Last Commit ID != New Commit ID");
         }
       }
     }
+  }
 
+  bool leader = false;
+  ctx.cid = txmgr.joinCommitGroup(leader);
+  TX_CODE result = TX_CODE::TX_OK;
+  if (mods) {
+    const auto& modifications = *mods;
+    // Only update the required positions
     for (auto& kv: modifications.inserted) {
-      auto weak_table = kv.first;
-      if (auto store = getStore(weak_table.lock())) {
-        auto result = store->commitPositions(kv.second, ctx.cid, true);
-        if (result != TX_CODE::TX_OK) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+      if (auto store = getStore(kv.first.lock())) {
+        if (store->commitPositions(kv.second, ctx.cid, true) != TX_CODE::TX_OK) {
+          result = TX_CODE::TX_FAIL_OTHER;
         }
       }
     }
 
     for (auto& kv: modifications.deleted) {
-      auto weak_table = kv.first;
-      if (auto store = getStore(weak_table.lock())) {
-        auto result = store->commitPositions(kv.second, ctx.cid, false);
-        if (result != TX_CODE::TX_OK) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+      if (auto store = getStore(kv.first.lock())) {
+        if (store->commitPositions(kv.second, ctx.cid, false) != TX_CODE::TX_OK) {
+          result = TX_CODE::TX_FAIL_OTHER;
         }
       }
     }
   }
-  txmgr.commit(ctx.tid);
+  // Every member has to leave, otherwise the group is never published
+  txmgr.leaveCommitGroup(ctx.cid, leader);
+  if (result != TX_CODE::TX_OK) {
+    throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+  }
+
+  txmgr.endTransaction(ctx.tid);
   return ctx.cid;
 }
 
@@ -3,13 +3,16 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "helper/locking.h"
-#include "helper/Synchronized.h"
 #include "helper/types.h"
+#include "io/TransactionRegistry.h"
 #include "io/TXContext.h"
 #include "storage/storage_types.h"
 
@@ -39,6 +42,9 @@ class TXModifications {
   // Keeps track of all inserted rows
   void insertPos(const storage::c_atable_ptr_t& tab, pos_t pos);
 
+  // Keeps track of the inserted rows [first, first + count)
+  void insertPosRange(const storage::c_atable_ptr_t& tab, pos_t first, size_t count);
+
   // Keeps track of all deleted rows
   void deletePos(const storage::c_atable_ptr_t& tab, pos_t pos);
 
@@ -69,8 +75,15 @@ class TransactionManager {
   /// @{
 
   /// Starts a new transaction context, creates TransactionData object
-  /// to be accessed through the returned context's `tid`.
-  static TXContext beginTransaction();
+  /// to be accessed through the returned context's `tid`. The snapshot
+  /// is pinned right away with `pin`, otherwise once the transaction
+  /// reads, see pinSnapshot.
+  static TXContext beginTransaction(bool pin = false);
+
+  /// Starts a read-only snapshot of the last commit, without a
+  /// transaction id and modification tracking. Committing or rolling
+  /// back a snapshot only releases it, modifying it throws.
+  static TXContext beginReadOnlyTransaction();
 
   /// Returns transaction data reference for modification
   /// \param tid transaction id
@@ -80,7 +93,8 @@ class TransactionManager {
   static TXContext getContext(transaction_id_t tid);
 
   /// Make all changes visible to other transaction, ending the lifetime
-  /// of the transaction context identified by tid
+  /// of the transaction context identified by tid. Concurrent commits
+  /// are grouped, see joinCommitGroup.
   /// \param tid transaction id to commit
   /// \returns commit id on success
   static transaction_cid_t commitTransaction(TXContext ctx);
@@ -106,7 +120,30 @@ class TransactionManager {
   * Builds the transaction context by fetching the new transaction id and the
   * last commit id
   */
-  TXContext buildContext();
+  TXContext buildContext(bool pin = false);
+
+  /*
+  * Pins the snapshot of ctx before the transaction reads under MVCC and
+  * renews the pin of a pinned one. Pins are released when the transaction
+  * commits or rolls back, or once it did not read for the snapshot
+  * timeout. Throws if rows the snapshot sees may have been collected
+  * already. Read-only snapshots are pinned from their begin.
+  */
+  void pinSnapshot(const TXContext& ctx);
+
+  /*
+  * Pins snapshot lastCid for a reader outside of a transaction, e.g. a
+  * result cursor, until it is unpinned with unpinReadOnlySnapshot. These
+  * pins do not expire. Throws like pinSnapshot if the snapshot is too old.
+  */
+  void pinReadOnlySnapshot(transaction_cid_t lastCid);
+  void unpinReadOnlySnapshot(transaction_cid_t lastCid);
+
+  /*
+  * Pins of transactions that did not read for that long expire, zero
+  * keeps them until the transaction ends
+  */
+  void setSnapshotTimeout(std::chrono::steady_clock::duration timeout);
 
   /*
 
@@ -132,6 +169,12 @@ class TransactionManager {
   */
   TXModifications& operator[](const transaction_id_t& key);
 
+  /*
+  * Returns the modifications of the given transaction id without
+  * registering the transaction if it did not modify anything yet
+  */
+  std::optional<const TXModifications&> getModifications(const transaction_id_t key) const;
+
   /**
   * This call relases the prepare commit lock and increments the commit ID
   * counter;
@@ -140,26 +183,91 @@ class TransactionManager {
 
   void endTransaction(transaction_id_t tid);
 
+  /*
+  * Returns the oldest snapshot a running transaction or read-only
+  * snapshot may still read, or the last commit id if there is none.
+  * Rows deleted at or before it are invisible to everyone, so older
+  * snapshots cannot be pinned anymore. Expired pins are released.
+  */
+  transaction_cid_t getOldestActiveSnapshot();
+
+  /*
+  * Whether tid belongs to a transaction that modified rows and neither
+  * committed nor rolled back yet, whether there is any
+  */
+  bool isRunning(transaction_id_t tid) const;
+  bool hasRunningTransactions() const;
+
+  /*
+  * Blocks commits until the returned lock is released, so that no
+  * commit ids are written to the stores meanwhile
+  */
+  std::unique_lock<locking::Spinlock> blockCommits();
+
+  /*
+  * Group commit: every committer joins the group of all committers
+  * waiting at that time. The first of them becomes the leader, assigns
+  * consecutive commit ids to the whole group at once and holds the
+  * prepare commit lock for the group. All members write their commit
+  * ids to the stores in parallel and leave the group. The leader
+  * publishes the last commit id of the group once all members left,
+  * so commit ids become visible in order. Members block on condition
+  * variables instead of spinning, committers arriving meanwhile form
+  * the next group.
+  *
+  * Returns the commit id of the caller, `leader` is set for the leader
+  */
+  transaction_cid_t joinCommitGroup(bool& leader);
+
+  /*
+  * Leaves the commit group after the positions were written with `cid`
+  * and returns once `cid` is visible
+  */
+  void leaveCommitGroup(transaction_cid_t cid, bool leader);
+
   void reset();
 
 
  private:
-  std::optional<const TXModifications&> getModifications(const transaction_id_t key) const;
-
   std::atomic<transaction_id_t> _transactionCount;
   std::atomic<transaction_cid_t> _commitId;
 
-  using map_t = std::unordered_map<transaction_id_t,
-                                   std::unique_ptr<TransactionData>>;
-
   // Keeping track of all transactions and their modifications
-  Synchronized<map_t, locking::Spinlock> _txData;
+  TransactionRegistry _txData;
 
   // Spin Lock for transactions
   locking::Spinlock _txLock;
 
+  // Group commit, see joinCommitGroup
+  std::mutex _groupMutex;
+  std::condition_variable _groupAssigned;
+  std::condition_variable _groupFinished;
+  std::vector<transaction_cid_t*> _pendingCommits;
+  bool _groupLeader = false;
+  size_t _unfinishedCommits = 0;
+  transaction_cid_t _groupLastCid = UNKNOWN_CID;
+
+  struct PinnedSnapshot {
+    transaction_cid_t lastCid;
+    std::chrono::steady_clock::time_point lastRead;
+  };
+
+  // Number of snapshots pinned per last commit id and the snapshots of
+  // the transactions that did not end yet
+  locking::Spinlock _snapshotLock;
+  std::map<transaction_cid_t, size_t> _snapshots;
+  std::unordered_map<transaction_id_t, PinnedSnapshot> _pinnedSnapshots;
+  std::chrono::steady_clock::duration _snapshotTimeout = std::chrono::steady_clock::duration::zero();
+  // Oldest active snapshot handed out last, older ones cannot be pinned
+  transaction_cid_t _collectedSnapshot = UNKNOWN_CID;
+
   TransactionManager();
 
+  // Pins the snapshot of the last commit id for tid and returns it,
+  // call with _snapshotLock held
+  transaction_cid_t pinLastCommit(transaction_id_t tid);
+  void unpinSnapshot(transaction_id_t tid);
+
   // Get next transaction id
   transaction_id_t getTransactionId();
 };
@@ -0,0 +1,126 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/TransactionRegistry.h"
+
+#include <mutex>
+
+#include "helper/EpochReclamation.h"
+#include "io/TransactionManager.h"
+
+namespace hyrise {
+namespace tx {
+
+struct TransactionRegistry::Node {
+  transaction_id_t tid = UNKNOWN;
+  TXData data;
+  std::atomic<Node*> next {nullptr};
+  locking::EpochReclamation::epoch_t retired = 0;
+};
+
+TransactionRegistry::TransactionRegistry() {}
+
+TransactionRegistry::~TransactionRegistry() {
+  for (auto& shard : _shards) {
+    for (Node* node = shard.head.load(); node != nullptr;) {
+      Node* next = node->next.load();
+      delete node;
+      node = next;
+    }
+    for (Node* node : shard.retired) {
+      delete node;
+    }
+  }
+}
+
+TransactionRegistry::Shard& TransactionRegistry::shardOf(transaction_id_t tid) const {
+  return _shards[tid % shardCount];
+}
+
+TransactionRegistry::Node* TransactionRegistry::find(const Shard& shard, transaction_id_t tid) {
+  for (Node* node = shard.head.load(std::memory_order_acquire); node != nullptr;
+       node = node->next.load(std::memory_order_acquire)) {
+    if (node->tid == tid) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+TransactionRegistry::Node* TransactionRegistry::allocate(Shard& shard) {
+  if (!shard.retired.empty() &&
+      locking::EpochReclamation::getInstance().isReclaimable(shard.retired.front()->retired)) {
+    Node* node = shard.retired.front();
+    shard.retired.pop_front();
+    node->data = TXData();
+    return node;
+  }
+  return new Node();
+}
+
+void TransactionRegistry::unlink(Shard& shard, Node* node) {
+  // Readers still traversing the node continue with its next pointer
+  std::atomic<Node*>* link = &shard.head;
+  while (link->load() != node) {
+    link = &link->load()->next;
+  }
+  link->store(node->next.load(), std::memory_order_release);
+  node->retired = locking::EpochReclamation::getInstance().retire();
+  shard.retired.push_back(node);
+}
+
+TXData& TransactionRegistry::getOrCreate(transaction_id_t tid) {
+  auto& shard = shardOf(tid);
+  {
+    locking::EpochReclamation::Guard guard;
+    if (Node* node = find(shard, tid)) {
+      return node->data;
+    }
+  }
+
+  std::lock_guard<locking::Spinlock> lock(shard.lock);
+  // Another task of the same transaction may have registered it
+  if (Node* node = find(shard, tid)) {
+    return node->data;
+  }
+  Node* node = allocate(shard);
+  node->tid = tid;
+  node->data._context.tid = tid;
+  node->data._modifications.tid = tid;
+  node->next.store(shard.head.load());
+  shard.head.store(node, std::memory_order_release);
+  return node->data;
+}
+
+TXData* TransactionRegistry::find(transaction_id_t tid) const {
+  locking::EpochReclamation::Guard guard;
+  Node* node = find(shardOf(tid), tid);
+  return node ? &node->data : nullptr;
+}
+
+void TransactionRegistry::erase(transaction_id_t tid) {
+  auto& shard = shardOf(tid);
+  std::lock_guard<locking::Spinlock> lock(shard.lock);
+  if (Node* node = find(shard, tid)) {
+    unlink(shard, node);
+  }
+}
+
+void TransactionRegistry::forEach(const std::function<void(const TXData&)>& fn) const {
+  locking::EpochReclamation::Guard guard;
+  for (const auto& shard : _shards) {
+    for (Node* node = shard.head.load(std::memory_order_acquire); node != nullptr;
+         node = node->next.load(std::memory_order_acquire)) {
+      fn(node->data);
+    }
+  }
+}
+
+void TransactionRegistry::clear() {
+  for (auto& shard : _shards) {
+    std::lock_guard<locking::Spinlock> lock(shard.lock);
+    while (Node* node = shard.head.load()) {
+      unlink(shard, node);
+    }
+  }
+}
+
+}}
@@ -0,0 +1,66 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+
+#include "helper/locking.h"
+#include "helper/types.h"
+
+namespace hyrise {
+namespace tx {
+
+struct TXData;
+
+/*
+ * Registry of the data of running transactions. Transactions are spread
+ * over shards by their id, every shard is a linked list that is read
+ * without locks and changed under the spinlock of the shard only.
+ * Removed entries are reused for later transactions once no reader can
+ * see them anymore, see locking::EpochReclamation.
+ *
+ * The data returned by getOrCreate and find stays valid until the
+ * transaction itself calls erase.
+ */
+class TransactionRegistry {
+ public:
+  static const size_t shardCount = 64;
+
+  TransactionRegistry();
+  ~TransactionRegistry();
+  TransactionRegistry(const TransactionRegistry&) = delete;
+  TransactionRegistry& operator=(const TransactionRegistry&) = delete;
+
+  /// Data of `tid`, registered on the first call
+  TXData& getOrCreate(transaction_id_t tid);
+
+  /// Data of `tid` or nullptr if it is not registered
+  TXData* find(transaction_id_t tid) const;
+
+  void erase(transaction_id_t tid);
+
+  /// Calls fn for the data of every registered transaction
+  void forEach(const std::function<void(const TXData&)>& fn) const;
+
+  void clear();
+
+ private:
+  struct Node;
+
+  struct alignas(64) Shard {
+    locking::Spinlock lock;
+    std::atomic<Node*> head {nullptr};
+    // Removed nodes in the order of removal, reused once reclaimable
+    std::deque<Node*> retired;
+  };
+
+  Shard& shardOf(transaction_id_t tid) const;
+  static Node* find(const Shard& shard, transaction_id_t tid);
+  static Node* allocate(Shard& shard);
+  static void unlink(Shard& shard, Node* node);
+
+  mutable Shard _shards[shardCount];
+};
+
+}}
@@ -0,0 +1,92 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/VersionCollector.h"
+
+#include "log4cxx/logger.h"
+
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace io {
+
+namespace {
+log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.io"));
+}
+
+const size_t VersionCollector::defaultMinimumRows;
+
+VersionCollector &VersionCollector::getInstance() {
+  static VersionCollector collector;
+  return collector;
+}
+
+VersionCollector::~VersionCollector() {
+  stop();
+}
+
+void VersionCollector::start(std::chrono::milliseconds interval) {
+  stop();
+  if (interval.count() == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  _interval = interval;
+  _stop = false;
+  _thread = std::thread(&VersionCollector::run, this);
+}
+
+void VersionCollector::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _wakeup.notify_all();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void VersionCollector::setMinimumRows(size_t rows) {
+  _minimumRows = rows;
+}
+
+size_t VersionCollector::getReclaimedRows() const {
+  return _reclaimedRows;
+}
+
+size_t VersionCollector::collect() {
+  auto& txmgr = tx::TransactionManager::getInstance();
+  auto* sm = StorageManager::getInstance();
+  size_t removed = 0;
+  for (const auto& name : sm->getTableNames()) {
+    sm->useExclusively(name, [&] (const std::shared_ptr<storage::AbstractResource>& resource) {
+        if (auto store = std::dynamic_pointer_cast<storage::Store>(resource)) {
+          // Commits write to the rows that are moved
+          auto commits = txmgr.blockCommits();
+          const size_t rows = store->compactDelta(txmgr.getOldestActiveSnapshot(), _minimumRows);
+          if (rows > 0) {
+            LOG4CXX_DEBUG(_logger, "Removed " << rows << " row versions from the delta of " << name);
+          }
+          removed += rows;
+        }
+      });
+  }
+  _reclaimedRows += removed;
+  return removed;
+}
+
+void VersionCollector::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_wakeup.wait_for(lock, _interval, [this] { return _stop; })) {
+    lock.unlock();
+    try {
+      collect();
+    } catch (const std::exception &e) {
+      LOG4CXX_ERROR(_logger, "Version collection failed: " << e.what());
+    }
+    lock.lock();
+  }
+}
+
+}}
@@ -0,0 +1,62 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace hyrise {
+namespace io {
+
+/*
+ * Removes row versions that no snapshot can see anymore from the deltas
+ * of the stores, see Store::compactDelta. Rows deleted at or before the
+ * oldest active snapshot (TransactionManager::getOldestActiveSnapshot)
+ * and rows of transactions that ended without committing are dropped,
+ * so update-heavy tables do not slow down every scan until the next
+ * merge.
+ *
+ * As rows move, a store is only compacted while nothing but the
+ * StorageManager references it, no query can load it meanwhile and
+ * commits wait. Stores held by running queries, cursors or transactions
+ * owning delta rows are left for a later pass.
+ */
+class VersionCollector {
+ public:
+  static const size_t defaultMinimumRows = 1024;
+
+  static VersionCollector &getInstance();
+
+  ~VersionCollector();
+
+  /// Collects every interval in a background thread, 0 stops it
+  void start(std::chrono::milliseconds interval);
+  void stop();
+
+  /// Stores are only compacted once that many delta rows are reclaimable
+  void setMinimumRows(size_t rows);
+
+  /// Compacts the deltas of all stores once, returns the removed rows
+  size_t collect();
+
+  /// Rows removed since the server started
+  size_t getReclaimedRows() const;
+
+ private:
+  VersionCollector() {}
+
+  void run();
+
+  std::mutex _mutex;
+  std::condition_variable _wakeup;
+  std::thread _thread;
+  std::chrono::milliseconds _interval {0};
+  bool _stop = false;
+
+  std::atomic<size_t> _minimumRows {defaultMinimumRows};
+  std::atomic<size_t> _reclaimedRows {0};
+};
+
+}}
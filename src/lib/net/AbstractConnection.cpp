@@ -6,4 +6,31 @@ namespace net {
 
 AbstractConnection::~AbstractConnection() {}
 
+std::string AbstractConnection::getHeader(const std::string &name) const {
+  return "";
+}
+
+void AbstractConnection::beginChunkedResponse(size_t status, const std::string& contentType) {
+  _chunkedBody.clear();
+  _chunkedStatus = status;
+  _chunkedContentType = contentType;
+}
+
+void AbstractConnection::writeChunk(const std::string &chunk) {
+  _chunkedBody.append(chunk);
+}
+
+void AbstractConnection::endChunkedResponse() {
+  respond(_chunkedBody, _chunkedStatus, _chunkedContentType);
+  _chunkedBody.clear();
+}
+
+bool AbstractConnection::isWritable() {
+  return true;
+}
+
+void AbstractConnection::whenWritable(std::function<void()> resume) {
+  resume();
+}
+
 }}
@@ -2,6 +2,7 @@
 #ifndef SRC_LIB_NET_ABSTRACTCONNECTION_H_
 #define SRC_LIB_NET_ABSTRACTCONNECTION_H_
 
+#include <functional>
 #include <string>
 
 namespace hyrise {
@@ -13,7 +14,30 @@ class AbstractConnection {
   virtual std::string getBody() const = 0;
   virtual std::string getPath() const = 0;
   virtual bool hasBody() const = 0;
+  /// Value of the request header `name` (case insensitive), empty if not sent
+  virtual std::string getHeader(const std::string &name) const;
   virtual void respond(const std::string &message, size_t status=200, const std::string& contentType="application/json") = 0;
+
+  /*
+   * Streaming responses, the body is sent in consecutive chunks while
+   * it is produced. The default implementation collects all chunks and
+   * calls respond once endChunkedResponse is called.
+   *
+   * Producers throttle themselves: while isWritable is false, the client
+   * lags behind and no further chunks should be written. Instead of
+   * waiting, the producer passes its continuation to whenWritable, which
+   * calls it once the client caught up, possibly from another thread.
+   */
+  virtual void beginChunkedResponse(size_t status=200, const std::string& contentType="application/json");
+  virtual void writeChunk(const std::string &chunk);
+  virtual void endChunkedResponse();
+  virtual bool isWritable();
+  virtual void whenWritable(std::function<void()> resume);
+
+ private:
+  std::string _chunkedBody;
+  size_t _chunkedStatus = 200;
+  std::string _chunkedContentType;
 };
 
 }
@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stddef.h>
 #include <ctime>
 #include <memory>
@@ -23,41 +24,64 @@ ebb_connection *new_connection(ebb_server *server, struct sockaddr_in *addr) {
     return nullptr;
   }
 
-  AsyncConnection *connection_data = new AsyncConnection;
-  connection_data->addr = *addr;
-  
+  ClientConnection *client = new ClientConnection;
+  client->connection = connection;
+  client->ev_loop = server->loop;
+  client->addr = *addr;
+
   // Initializes the connection
   ebb_connection_init(connection);
-  connection->data = connection_data;
+  connection->data = client;
   connection->new_request = new_request;
   connection->on_close = on_close;
   connection->on_timeout = on_timeout;
 
-  connection_data->ev_loop = server->loop;
-  connection_data->ev_write.data = connection_data;
-
   return connection;
 }
 
 int on_timeout(ebb_connection *connection) {
+  // The timeout restarts whenever the client reads, a chunk that is still
+  // being written means the client stopped reading the streamed response
+  ClientConnection *client = (ClientConnection *)connection->data;
+  if (!client->requests.empty()) {
+    AsyncConnection *conn = client->requests.front();
+    std::lock_guard<std::mutex> lock(conn->chunk_mutex);
+    if (conn->streaming && conn->chunk_writing) {
+      return EBB_STOP;
+    }
+  }
   return EBB_AGAIN;
 }
 
 ebb_request *new_request(ebb_connection *connection) {
+  ClientConnection *client = (ClientConnection *)connection->data;
+
+  AsyncConnection *connection_data = new AsyncConnection;
+  connection_data->connection = connection;
+  connection_data->client = client;
+  connection_data->addr = client->addr;
+  connection_data->ev_loop = client->ev_loop;
+  connection_data->ev_write.data = connection_data;
+  client->receiving = connection_data;
+
   ebb_request *request = (ebb_request *)malloc(sizeof(ebb_request));
   ebb_request_init(request);
-  request->data = connection;
+  request->data = connection_data;
   request->on_complete = request_complete;
   request->on_path = request_path;
   request->on_body = request_body;
+  request->on_header_field = request_header_field;
+  request->on_header_value = request_header_value;
+  connection_data->request = request;
   return request;
 }
 
 void request_complete(ebb_request *request) {
-  ebb_connection *connection = (ebb_connection *)request->data;
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
-  connection_data->connection = connection;
-  connection_data->request = request;
+  AsyncConnection *connection_data = (AsyncConnection *)request->data;
+  ClientConnection *client = connection_data->client;
+  client->receiving = nullptr;
+  client->requests.push_back(connection_data);
+
   gettimeofday(&connection_data->starttime, nullptr);
   connection_data->keep_alive_flag = ebb_request_should_keep_alive(request);
 
@@ -78,23 +102,25 @@ void request_complete(ebb_request *request) {
   auto task = handler_factory->create(connection_data);
   task->setPriority(taskscheduler::Task::HIGH_PRIORITY); // give RequestParseTask high priority
   taskscheduler::SharedScheduler::getInstance().getScheduler()->schedule(task);
-  connection_data->waiting_for_response = true;
 }
 
 void continue_responding(ebb_connection *connection) {
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
-  if (connection_data->keep_alive_flag == false) {
+  ClientConnection *client = (ClientConnection *)connection->data;
+  AsyncConnection *connection_data = client->requests.front();
+  client->requests.pop_front();
+  const bool keep_alive = connection_data->keep_alive_flag;
+  delete connection_data;
+
+  if (keep_alive == false) {
     ebb_connection_schedule_close(connection);
-  }
-  else {
-    // clear connection for next request
-    connection_data->reset();
+  } else if (!client->requests.empty() && client->requests.front()->response_ready) {
+    // the response to the next pipelined request is already waiting
+    write_response(client->requests.front());
   }
 }
 
 void request_path(ebb_request *request, const char *at, size_t length) {
-  ebb_connection *connection = (ebb_connection *)request->data;
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
+  AsyncConnection *connection_data = (AsyncConnection *)request->data;
 
   connection_data->path = (char *)malloc(length + 1);
   strncpy(connection_data->path, at, length);
@@ -102,8 +128,7 @@ void request_path(ebb_request *request, const char *at, size_t length) {
 }
 
 void request_body(ebb_request *request, const char *at, size_t length) {
-  ebb_connection *connection = (ebb_connection *)request->data;
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
+  AsyncConnection *connection_data = (AsyncConnection *)request->data;
 
   if (!connection_data->body) {
     connection_data->body = (char *)malloc(length);
@@ -115,9 +140,24 @@ void request_body(ebb_request *request, const char *at, size_t length) {
   connection_data->body_len += length;
 }
 
-void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
-  AsyncConnection *conn = (AsyncConnection *) w->data;
+void request_header_field(ebb_request *request, const char *at, size_t length, int header_index) {
+  AsyncConnection *connection_data = (AsyncConnection *)request->data;
+  // Fields and values may arrive in several pieces
+  if (connection_data->headers.size() <= (size_t) header_index) {
+    connection_data->headers.resize(header_index + 1);
+  }
+  connection_data->headers[header_index].first.append(at, length);
+}
 
+void request_header_value(ebb_request *request, const char *at, size_t length, int header_index) {
+  AsyncConnection *connection_data = (AsyncConnection *)request->data;
+  if (connection_data->headers.size() <= (size_t) header_index) {
+    connection_data->headers.resize(header_index + 1);
+  }
+  connection_data->headers[header_index].second.append(at, length);
+}
+
+static void log_request(AsyncConnection *conn, bool sent) {
   char *method = (char *) "";
   switch (conn->request->method) {
     case EBB_GET:
@@ -141,29 +181,129 @@ void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
   timeinfo = localtime(&rawtime);
   strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S %z", timeinfo);
 
+  printf("%s [%s] %s %s (%f s)%s\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration,
+         sent ? "" : " not sent");
+}
+
+void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
+  AsyncConnection *conn = (AsyncConnection *) w->data;
+  conn->response_ready = true;
+
+  // Responses to pipelined requests wait until the previous responses are written
+  if (conn->connection != nullptr && conn->client->requests.front() != conn) {
+    return;
+  }
+  write_response(conn);
+}
+
+void write_response(AsyncConnection *conn) {
+  if (conn->streaming) {
+    write_next_chunk(conn);
+    return;
+  }
+
   // Handle the actual writing
+  ev_async_stop(conn->ev_loop, &conn->ev_write);
   if (conn->connection != nullptr) {
+    log_request(conn, true);
     ebb_connection_write(conn->connection, conn->write_buffer, conn->write_buffer_len, continue_responding);
-    printf("%s [%s] %s %s (%f s)\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
   } else {
-    printf("%s [%s] %s %s (%f s) not sent\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
+    // When connection is nullptr, `continue_responding` won't fire since we never sent data to the client,
+    // thus, we'll need to clean up manually here, while connection has already been cleaned up in on `on_close`
+    log_request(conn, false);
+    delete conn;
+  }
+}
+
+void write_next_chunk(AsyncConnection *conn) {
+  std::unique_lock<std::mutex> lock(conn->chunk_mutex);
+
+  if (conn->connection == nullptr) {
+    // The client is gone, drop the remaining chunks
+    conn->chunks.clear();
+    conn->queued_bytes = 0;
+    if (conn->chunks_done) {
+      lock.unlock();
+      log_request(conn, false);
+      ev_async_stop(conn->ev_loop, &conn->ev_write);
+      delete conn;
+    }
+    return;
+  }
+
+  if (conn->chunk_writing) {
+    return;
+  }
+
+  if (!conn->chunks.empty()) {
+    conn->current_chunk = std::move(conn->chunks.front());
+    conn->chunks.pop_front();
+    conn->chunk_writing = true;
+    lock.unlock();
+    ebb_connection_write(conn->connection, conn->current_chunk.data(), conn->current_chunk.size(), chunk_written);
+  } else if (conn->chunks_done) {
+    conn->streaming = false;
+    lock.unlock();
+    log_request(conn, true);
+    ev_async_stop(conn->ev_loop, &conn->ev_write);
+    continue_responding(conn->connection);
+  }
+}
+
+void chunk_written(ebb_connection *connection) {
+  // Only the response to the first request is written
+  AsyncConnection *conn = ((ClientConnection *)connection->data)->requests.front();
+  std::function<void()> resume;
+  {
+    std::lock_guard<std::mutex> lock(conn->chunk_mutex);
+    conn->chunk_writing = false;
+    conn->queued_bytes -= conn->current_chunk.size();
+    conn->current_chunk.clear();
+    if (conn->on_writable && conn->queued_bytes <= AsyncConnection::resume_queued_bytes) {
+      resume = std::move(conn->on_writable);
+      conn->on_writable = nullptr;
+    }
+  }
+  // The response is not done while its producer waits, conn stays valid
+  write_next_chunk(conn);
+  if (resume) {
+    resume();
   }
-  ev_async_stop(conn->ev_loop, &conn->ev_write);
-  conn->waiting_for_response = false;
-  // When connection is nullptr, `continue_responding` won't fire since we never sent data to the client,
-  // thus, we'll need to clean up manually here, while connection has already been cleaned up in on `on_close`
-  if (conn->connection == nullptr) delete conn;
 }
 
 void on_close(ebb_connection *connection) {
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
-  connection_data->connection = nullptr;
+  ClientConnection *client = (ClientConnection *)connection->data;
+  delete client->receiving;
+
+  for (AsyncConnection *connection_data : client->requests) {
+    // Requests whose handler is still running are deleted once it responded, see write_response
+    bool responded;
+    std::function<void()> resume;
+    {
+      std::lock_guard<std::mutex> lock(connection_data->chunk_mutex);
+      connection_data->connection = nullptr;
+      connection_data->client = nullptr;
+      responded = connection_data->response_ready && (!connection_data->streaming || connection_data->chunks_done);
+      resume = std::move(connection_data->on_writable);
+      connection_data->on_writable = nullptr;
+    }
+    // A waiting producer finishes its response, which is dropped
+    if (resume) {
+      resume();
+    }
+    if (responded) {
+      ev_async_stop(connection_data->ev_loop, &connection_data->ev_write);
+      delete connection_data;
+    }
+  }
+
   free(connection);
-  if (!connection_data->waiting_for_response)
-    delete connection_data;
+  delete client;
 }
 
 AsyncConnection::AsyncConnection() :
+    connection(nullptr),
+    client(nullptr),
     request(nullptr),
     path(nullptr),
     body(nullptr), body_len(0), write_buffer(nullptr) {
@@ -178,7 +318,15 @@ void AsyncConnection::reset() {
   free(body); body_len = 0; body = nullptr;
   free(request); request = nullptr;
   free(write_buffer); write_buffer = nullptr;
-  waiting_for_response = false;
+  response_ready = false;
+
+  streaming = false;
+  chunk_writing = false;
+  chunks_done = false;
+  queued_bytes = 0;
+  chunks.clear();
+  current_chunk.clear();
+  on_writable = nullptr;
 }
 
 void AsyncConnection::respond(const std::string &message, size_t status, const std::string & contentType) {
@@ -200,6 +348,76 @@ void AsyncConnection::respond(const std::string &message, size_t status, const s
   send_response();
 }
 
+void AsyncConnection::beginChunkedResponse(size_t status, const std::string& contentType) {
+  char header[max_header_length];
+  snprintf(header, max_header_length,
+           "HTTP/1.1 %lu OK\r\nContent-Type: %s\r\nTransfer-Encoding: chunked\r\nConnection: %s\r\n\r\n",
+           status,
+           contentType.c_str(),
+           keep_alive_flag ? "Keep-Alive" : "Close");
+  {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    streaming = true;
+    chunks_done = false;
+  }
+  queueChunk(header);
+}
+
+void AsyncConnection::writeChunk(const std::string &chunk) {
+  // An empty chunk would terminate the response
+  if (chunk.empty()) {
+    return;
+  }
+
+  char size[24];
+  snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+  std::string frame;
+  frame.reserve(chunk.size() + 32);
+  frame.append(size).append(chunk).append("\r\n");
+  queueChunk(std::move(frame));
+}
+
+void AsyncConnection::endChunkedResponse() {
+  {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    if (connection != nullptr) {
+      chunks.push_back("0\r\n\r\n");
+    }
+    chunks_done = true;
+    // Sent while locked, on_close may delete the connection once chunks_done is set
+    send_response();
+  }
+}
+
+bool AsyncConnection::isWritable() {
+  std::lock_guard<std::mutex> lock(chunk_mutex);
+  return queued_bytes < max_queued_bytes || connection == nullptr;
+}
+
+void AsyncConnection::whenWritable(std::function<void()> resume) {
+  {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    if (queued_bytes >= max_queued_bytes && connection != nullptr) {
+      // Called by the event loop, see chunk_written and on_close
+      on_writable = std::move(resume);
+      return;
+    }
+  }
+  resume();
+}
+
+void AsyncConnection::queueChunk(std::string chunk) {
+  {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    if (connection == nullptr) {
+      return;
+    }
+    queued_bytes += chunk.size();
+    chunks.push_back(std::move(chunk));
+  }
+  send_response();
+}
+
 void AsyncConnection::send_response() {
   ev_async_send(ev_loop, &ev_write);
 }
@@ -212,6 +430,15 @@ std::string AsyncConnection::getPath() const {
   return path;
 }
 
+std::string AsyncConnection::getHeader(const std::string &name) const {
+  for (const auto& header : headers) {
+    if (strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+      return header.second;
+    }
+  }
+  return "";
+}
+
 std::string AsyncConnection::getBody() const{
   return std::string(body, body_len);
 }
@@ -7,7 +7,12 @@
 #include <cstdlib>
 #include <ev.h>
 
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "net/AbstractConnection.h"
 
@@ -18,11 +23,31 @@
 namespace hyrise {
 namespace net {
 
+class AsyncConnection;
+
+/// State of one client connection. The connection is kept alive between
+/// requests and further requests may be pipelined before the first one
+/// is answered. Responses are written in request order, a response that
+/// is ready early waits for the ones of the previous requests.
+/// Only accessed from the event loop of the connection.
+struct ClientConnection {
+  ebb_connection *connection;
+  struct ev_loop *ev_loop;
+  struct sockaddr_in addr;
+  // Requests waiting for their response to be written, in request order
+  std::deque<AsyncConnection *> requests;
+  // Request that is being received
+  AsyncConnection *receiving = nullptr;
+};
+
+/// One request of a client connection and its response
 class AsyncConnection : public AbstractConnection {
  public:
   ev_async ev_write;
   struct ev_loop *ev_loop;
+  // Both are nullptr once the client closed the connection
   ebb_connection *connection;
+  ClientConnection *client;
   ebb_request *request;
   struct sockaddr_in addr;
   struct timeval starttime;
@@ -31,11 +56,32 @@ class AsyncConnection : public AbstractConnection {
   char *body;
   size_t body_len;
 
+  // Request headers as (field, value) in the order they were received
+  std::vector<std::pair<std::string, std::string>> headers;
+
   char *write_buffer;
   size_t write_buffer_len;
 
   bool keep_alive_flag;
-  bool waiting_for_response = false;
+  // Set by the event loop once the response (or its first chunk) arrived
+  bool response_ready = false;
+
+  // Chunked responses, chunks are queued by the responding thread and
+  // written one at a time by the event loop. The responding thread never
+  // waits for the client: it stops producing once max_queued_bytes are
+  // queued and is resumed through on_writable once they drained to
+  // resume_queued_bytes. A stream that the client does not read for the
+  // connection timeout is aborted, see on_timeout.
+  static const size_t max_queued_bytes = 4 * 1024 * 1024;
+  static const size_t resume_queued_bytes = max_queued_bytes / 2;
+  bool streaming = false;
+  bool chunk_writing = false;
+  bool chunks_done = false;
+  size_t queued_bytes = 0;
+  std::deque<std::string> chunks;
+  std::string current_chunk;
+  std::mutex chunk_mutex;
+  std::function<void()> on_writable;
 
   AsyncConnection();
   ~AsyncConnection();
@@ -43,8 +89,15 @@ class AsyncConnection : public AbstractConnection {
   virtual std::string getBody() const;
   virtual bool hasBody() const;
   virtual std::string getPath() const;
+  virtual std::string getHeader(const std::string &name) const;
   virtual void respond(const std::string &message, size_t status=200, const std::string& contentType="application/json");
+  virtual void beginChunkedResponse(size_t status=200, const std::string& contentType="application/json");
+  virtual void writeChunk(const std::string &chunk);
+  virtual void endChunkedResponse();
+  virtual bool isWritable();
+  virtual void whenWritable(std::function<void()> resume);
  private:
+  void queueChunk(std::string chunk);
   virtual void send_response();
 };
 
@@ -58,10 +111,20 @@ void request_path(ebb_request *request, const char *at, size_t length);
 
 void request_body(ebb_request *request, const char *at, size_t length);
 
+void request_header_field(ebb_request *request, const char *at, size_t length, int header_index);
+
+void request_header_value(ebb_request *request, const char *at, size_t length, int header_index);
+
 void write_cb(struct ev_loop *loop, struct ev_async *w, int revents);
 
+void write_response(AsyncConnection *conn);
+
 void continue_responding(ebb_connection *connection);
 
+void write_next_chunk(AsyncConnection *conn);
+
+void chunk_written(ebb_connection *connection);
+
 void on_close(ebb_connection *connection);
 
 int on_timeout(ebb_connection *connection);
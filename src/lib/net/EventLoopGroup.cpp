@@ -0,0 +1,174 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "net/EventLoopGroup.h"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "log4cxx/logger.h"
+
+#include "helper/HwlocHelper.h"
+#include "net/AsyncConnection.h"
+
+namespace hyrise {
+namespace net {
+
+namespace {
+
+log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.net"));
+
+int bindSocket(size_t port, bool reusePort) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd == -1) {
+    perror("socket()");
+    return -1;
+  }
+
+  int flags = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (void *)&flags, sizeof(flags));
+  setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, (void *)&flags, sizeof(flags));
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (void *)&flags, sizeof(flags));
+  if (reusePort && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (void *)&flags, sizeof(flags)) == -1) {
+    perror("setsockopt(SO_REUSEPORT)");
+    close(fd);
+    return -1;
+  }
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) == -1) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+}
+
+EventLoopGroup::EventLoopGroup(size_t loops, const std::vector<int>& cores) {
+  for (size_t i = 0; i < std::max<size_t>(loops, 1); ++i) {
+    std::unique_ptr<Loop> loop(new Loop);
+    loop->loop = ev_loop_new(EVFLAG_AUTO);
+    ebb_server_init(&loop->server, loop->loop);
+    loop->server.new_connection = new_connection;
+    loop->server.data = this;
+    ev_async_init(&loop->ev_shutdown, shutdown_cb);
+    loop->ev_shutdown.data = loop.get();
+    ev_async_start(loop->loop, &loop->ev_shutdown);
+    // The shutdown watcher alone does not keep the loop running
+    ev_unref(loop->loop);
+    if (i < cores.size()) {
+      loop->core = cores[i];
+    }
+    _loops.push_back(std::move(loop));
+  }
+}
+
+EventLoopGroup::~EventLoopGroup() {
+  for (auto& thread : _threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  for (auto& loop : _loops) {
+    ev_loop_destroy(loop->loop);
+  }
+}
+
+bool EventLoopGroup::listen(size_t port) {
+  if (_loops.size() > 1) {
+    // Sockets with SO_REUSEPORT would share the port with another server
+    // of the same user, a socket without it fails if the port is in use
+    int probe = bindSocket(port, false);
+    if (probe == -1) {
+      return false;
+    }
+    close(probe);
+  }
+
+  for (auto& loop : _loops) {
+    loop->fd = bindSocket(port, _loops.size() > 1);
+    if (loop->fd == -1) {
+      closeSockets();
+      return false;
+    }
+  }
+
+  for (auto& loop : _loops) {
+    // The server owns the socket from now on
+    if (ebb_server_listen_on_fd(&loop->server, loop->fd) == -1) {
+      throw std::runtime_error("Could not listen on port " + std::to_string(port));
+    }
+  }
+  return true;
+}
+
+void EventLoopGroup::closeSockets() {
+  for (auto& loop : _loops) {
+    if (loop->fd != -1) {
+      close(loop->fd);
+      loop->fd = -1;
+    }
+  }
+}
+
+void EventLoopGroup::run() {
+  for (size_t i = 1; i < _loops.size(); ++i) {
+    Loop& loop = *_loops[i];
+    std::thread thread(&EventLoopGroup::runLoop, std::ref(loop));
+    if (loop.core >= 0) {
+      bindThreadToCore(thread.native_handle(), loop.core);
+    }
+    _threads.push_back(std::move(thread));
+  }
+
+  LOG4CXX_INFO(_logger, "Running " << _loops.size() << " event loop(s)");
+
+  Loop& first = *_loops.front();
+  if (first.core >= 0) {
+    bindThreadToCore(pthread_self(), first.core);
+  }
+  runLoop(first);
+
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+  _threads.clear();
+}
+
+void EventLoopGroup::shutdown() {
+  for (auto& loop : _loops) {
+    ev_async_send(loop->loop, &loop->ev_shutdown);
+  }
+}
+
+size_t EventLoopGroup::size() const {
+  return _loops.size();
+}
+
+void EventLoopGroup::runLoop(Loop& loop) {
+  ev_loop(loop.loop, 0);
+}
+
+void EventLoopGroup::shutdown_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
+  Loop *l = (Loop *) w->data;
+  ebb_server_unlisten(&l->server);
+  ev_ref(loop);
+  ev_async_stop(loop, w);
+}
+
+}
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_NET_EVENTLOOPGROUP_H_
+#define SRC_LIB_NET_EVENTLOOPGROUP_H_
+
+#include <ev.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ebb/ebb.h"
+
+namespace hyrise {
+namespace net {
+
+/// Runs several libev event loops, each in its own thread with its own
+/// ebb server. Every server listens on its own socket bound to the same
+/// port with SO_REUSEPORT, so the kernel distributes the incoming
+/// connections among the loops. A connection stays on the loop that
+/// accepted it, including its ev_async write wakeups.
+class EventLoopGroup {
+ public:
+  /// Creates `loops` event loops, loop i is pinned to cores[i] if given
+  EventLoopGroup(size_t loops, const std::vector<int>& cores = {});
+  ~EventLoopGroup();
+
+  /// Binds all servers to `port`, returns false if the port is in use
+  bool listen(size_t port);
+
+  /// Runs the loops, the first one in the calling thread, and returns
+  /// once all of them are finished
+  void run();
+
+  /// Stops listening on all servers, the loops finish after their open
+  /// connections are closed. May be called from any loop.
+  void shutdown();
+
+  size_t size() const;
+
+ private:
+  struct Loop {
+    struct ev_loop *loop;
+    ebb_server server;
+    ev_async ev_shutdown;
+    int fd = -1;
+    int core = -1;
+  };
+
+  void closeSockets();
+  static void runLoop(Loop& loop);
+  static void shutdown_cb(struct ev_loop *loop, struct ev_async *w, int revents);
+
+  std::vector<std::unique_ptr<Loop>> _loops;
+  std::vector<std::thread> _threads;
+};
+
+}
+}
+
+#endif  // SRC_LIB_NET_EVENTLOOPGROUP_H_
@@ -1,6 +1,7 @@
 #include "net/ShutdownHandler.h"
 #include <iostream>
 #include "net/AsyncConnection.h"
+#include "net/EventLoopGroup.h"
 #include "ebb/ebb.h"
 
 namespace hyrise {
@@ -20,8 +21,14 @@ const std::string ShutdownHandler::vname() {
 
 void ShutdownHandler::operator()() {
   if (auto ac = dynamic_cast<AsyncConnection*>(_connection)) {
+    // The connection may be gone once the response is written
+    ebb_server *server = ac->connection->server;
     ac->respond("shutting down");
-    ebb_server_unlisten(ac->connection->server);
+    if (auto loops = static_cast<EventLoopGroup*>(server->data)) {
+      loops->shutdown();
+    } else {
+      ebb_server_unlisten(server);
+    }
   }
 }
 
@@ -105,6 +105,20 @@ for (const field_t & field: *fields) {
   return valueIdList;
 }
 
+const size_t AbstractTable::valueBatchSize;
+
+void AbstractTable::getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const {
+  for (size_t i = 0; i < count; ++i) {
+    buffer[i] = getValueId(column, row + i);
+  }
+}
+
+void AbstractTable::getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const {
+  for (size_t i = 0; i < count; ++i) {
+    buffer[i] = getValueId(column, rows[i]);
+  }
+}
+
 std::string AbstractTable::printValue(const size_t column, const size_t row) const {
   return HyriseHelper::castValueByColumnRow<std::string>(this, column, row);
 }
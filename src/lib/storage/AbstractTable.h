@@ -6,6 +6,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <stdexcept>
@@ -223,6 +224,30 @@ public:
   virtual ValueId getValueId(size_t column, size_t row) const = 0;
 
 
+  /**
+   * Fills buffer with the value-IDs of a range of rows of one column.
+   * The default implementation calls getValueId for every row, derived
+   * classes resolve the column once and read the whole range at once.
+   *
+   * @param column Column number.
+   * @param row    First row of the range.
+   * @param count  Number of rows, buffer must hold at least count entries.
+   * @param buffer Target for the value-IDs.
+   */
+  virtual void getValueIdRange(size_t column, size_t row, size_t count, ValueId *buffer) const;
+
+
+  /**
+   * Fills buffer with the value-IDs of a list of rows of one column.
+   *
+   * @param column Column number.
+   * @param rows   Rows to read, in any order.
+   * @param count  Number of rows, buffer must hold at least count entries.
+   * @param buffer Target for the value-IDs.
+   */
+  virtual void getValueIdsAt(size_t column, const pos_t *rows, size_t count, ValueId *buffer) const;
+
+
   /**
    * Sets the value ID of a cell.
    * @note Should be implemented in derived classes or throws runtime error!
@@ -364,6 +389,50 @@ public:
   }
 
 
+  /**
+   * Templated method for retrieving the values of a range of rows of one
+   * column. The value-IDs are read in batches and decoded with one
+   * dictionary lookup per batch and table.
+   *
+   * @param column Column number.
+   * @param row    First row of the range.
+   * @param count  Number of rows, buffer must hold at least count entries.
+   * @param buffer Target for the values.
+   */
+  template <typename T>
+  void getValueRange(const field_t column, const size_t row, const size_t count, T *buffer) const {
+    ValueId valueIds[valueBatchSize];
+    for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+      const size_t n = std::min(valueBatchSize, count - offset);
+      getValueIdRange(column, row + offset, n, valueIds);
+      decodeValueIds(column, valueIds, n, buffer + offset, [row, offset] (size_t i) { return row + offset + i; });
+    }
+  }
+
+
+  /**
+   * Templated method for retrieving the values of a list of rows of one
+   * column.
+   *
+   * @param column Column number.
+   * @param rows   Rows to read, in any order.
+   * @param count  Number of rows, buffer must hold at least count entries.
+   * @param buffer Target for the values.
+   */
+  template <typename T>
+  void getValuesAt(const field_t column, const pos_t *rows, const size_t count, T *buffer) const {
+    ValueId valueIds[valueBatchSize];
+    for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+      const size_t n = std::min(valueBatchSize, count - offset);
+      getValueIdsAt(column, rows + offset, n, valueIds);
+      decodeValueIds(column, valueIds, n, buffer + offset, [rows, offset] (size_t i) { return rows[offset + i]; });
+    }
+  }
+
+  /// Number of value-IDs the batched value accessors decode at once
+  static const size_t valueBatchSize = 1024;
+
+
   /**
    * Templated method for retrieving a value from a cell.
    *
@@ -480,6 +549,23 @@ public:
   void setUuid(unique_id = unique_id());
 
  private:
+  // Decodes value-IDs into values, the dictionary is only looked up again
+  // when the table of the value-ID changes. rowOf maps an index of the
+  // batch to its row, which locates the dictionary of table 0.
+  template <typename T, typename RowFunctor>
+  void decodeValueIds(const field_t column, const ValueId *valueIds, const size_t count, T *buffer, RowFunctor rowOf) const {
+    BaseDictionary<T> *dict = nullptr;
+    table_id_t dict_table = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (dict == nullptr || valueIds[i].table != dict_table) {
+        dict_table = valueIds[i].table;
+        const auto& d = (dict_table != 0) ? dictionaryByTableId(column, dict_table) : dictionaryAt(column, rowOf(i));
+        dict = static_cast<BaseDictionary<T>*>(d.get());
+      }
+      buffer[i] = dict->getValueForValueId(valueIds[i].valueId);
+    }
+  }
+
   // Global unique identifier for this object
   unique_id _uuid;
 };
@@ -28,6 +28,25 @@ public:
   */
   virtual T get(size_t column, size_t row) const = 0;
 
+  /*
+  * Get the values of count consecutive rows of one column, starting at row.
+  * Implementations should override this to avoid a virtual call per value.
+  */
+  virtual void getRange(size_t column, size_t row, size_t count, T *buffer) const {
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = get(column, row + i);
+    }
+  }
+
+  /*
+  * Get the values of the given rows of one column
+  */
+  virtual void getAt(size_t column, const size_t *rows, size_t count, T *buffer) const {
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = get(column, rows[i]);
+    }
+  }
+
   /*
   * Set the value identified by column and row
   */
@@ -103,6 +103,18 @@ public:
     return result;
   }
 
+  void getRange(size_t column, size_t row, size_t count, T *buffer) const {
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = BitCompressedVector::get(column, row + i);
+    }
+  }
+
+  void getAt(size_t column, const size_t *rows, size_t count, T *buffer) const {
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = BitCompressedVector::get(column, rows[i]);
+    }
+  }
+
   void set(size_t column, size_t row, T value) {
     checkAccess(column, row);
 #ifdef EXPENSIVE_ASSERTIONS
@@ -0,0 +1,338 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/CompactPositionList.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "helper/make_unique.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+// Bytes needed by a bitmap covering positions [0, universe) including
+// the rank and select directories
+size_t bitmapBytes(size_t universe) {
+  return (universe / 8) + (universe / 64) + (universe / 256);
+}
+
+size_t wordsFor(size_t universe) {
+  return (universe + 63) / 64;
+}
+
+// Position of the n-th set bit in word
+size_t selectInWord(uint64_t word, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    word &= word - 1;
+  }
+  return __builtin_ctzll(word);
+}
+
+}
+
+CompactPositionList::CompactPositionList(Representation r) : _representation(r) {}
+
+std::unique_ptr<CompactPositionList> CompactPositionList::fromRange(pos_t first, size_t size) {
+  std::unique_ptr<CompactPositionList> result(new CompactPositionList(Representation::Range));
+  result->_first = first;
+  result->_size = size;
+  return result;
+}
+
+std::unique_ptr<CompactPositionList> CompactPositionList::compact(const pos_list_t& positions) {
+  if (positions.size() < minCompactSize) {
+    return nullptr;
+  }
+
+  bool increasing = true;
+  pos_t max = positions.front();
+  for (size_t i = 1, e = positions.size(); i < e; ++i) {
+    if (positions[i] <= positions[i - 1]) increasing = false;
+    if (positions[i] > max) max = positions[i];
+  }
+
+  if (increasing && positions.back() - positions.front() + 1 == positions.size()) {
+    return fromRange(positions.front(), positions.size());
+  }
+
+  const bool fitsNarrow = max <= std::numeric_limits<uint32_t>::max();
+  const size_t listBytes = positions.size() * (fitsNarrow ? sizeof(uint32_t) : sizeof(pos_t));
+
+  if (increasing && bitmapBytes(max + 1) < listBytes) {
+    std::vector<uint64_t> words(wordsFor(max + 1), 0);
+    for (const auto& p : positions) {
+      words[p >> 6] |= 1ull << (p & 63);
+    }
+    return buildBitmap(std::move(words));
+  }
+
+  if (fitsNarrow) {
+    std::unique_ptr<CompactPositionList> result(new CompactPositionList(Representation::Narrow));
+    result->_narrow.assign(positions.begin(), positions.end());
+    result->_size = positions.size();
+    result->_sorted = increasing;
+    return result;
+  }
+
+  return nullptr;
+}
+
+std::unique_ptr<CompactPositionList> CompactPositionList::buildBitmap(std::vector<uint64_t> words) {
+  std::unique_ptr<CompactPositionList> result(new CompactPositionList(Representation::Bitmap));
+  result->_bitmap = std::move(words);
+  result->buildDirectory();
+  return result;
+}
+
+void CompactPositionList::buildDirectory() {
+  const size_t blocks = (_bitmap.size() + blockWords - 1) / blockWords;
+  _blockRanks.assign(blocks + 1, 0);
+  _selectSamples.clear();
+
+  uint64_t rank = 0;
+  for (size_t b = 0; b < blocks; ++b) {
+    _blockRanks[b] = rank;
+    for (size_t w = b * blockWords, e = std::min(w + blockWords, _bitmap.size()); w < e; ++w) {
+      rank += __builtin_popcountll(_bitmap[w]);
+    }
+    // sample every block in which a multiple of sampleRate is reached
+    while (_selectSamples.size() * sampleRate < rank) {
+      _selectSamples.push_back(b);
+    }
+  }
+  _blockRanks[blocks] = rank;
+  _size = rank;
+}
+
+pos_t CompactPositionList::select(size_t index) const {
+  assert(index < _size);
+
+  // Narrow down the candidate blocks with the select samples, then find
+  // the block with the rank directory and scan its words
+  const size_t sample = index / sampleRate;
+  const auto first = _blockRanks.begin() + _selectSamples[sample];
+  const auto last = (sample + 1 < _selectSamples.size()) ?
+      _blockRanks.begin() + _selectSamples[sample + 1] + 1 : _blockRanks.end();
+  const size_t block = std::distance(_blockRanks.begin(), std::upper_bound(first, last, index)) - 1;
+
+  size_t remaining = index - _blockRanks[block];
+  for (size_t w = block * blockWords;; ++w) {
+    const size_t count = __builtin_popcountll(_bitmap[w]);
+    if (remaining < count) {
+      return (w << 6) + selectInWord(_bitmap[w], remaining);
+    }
+    remaining -= count;
+  }
+}
+
+void CompactPositionList::copyTo(const size_t index, const size_t count, pos_t *buffer) const {
+  assert(index + count <= _size);
+  switch (_representation) {
+    case Representation::Range:
+      for (size_t i = 0; i < count; ++i) buffer[i] = _first + index + i;
+      break;
+    case Representation::Narrow:
+      std::copy(_narrow.begin() + index, _narrow.begin() + index + count, buffer);
+      break;
+    case Representation::Bitmap: {
+      if (count == 0) return;
+      const pos_t first = select(index);
+      size_t w = first >> 6;
+      // mask out the bits before the first position
+      uint64_t word = _bitmap[w] & (~0ull << (first & 63));
+      for (size_t i = 0; i < count;) {
+        while (word && i < count) {
+          buffer[i++] = (w << 6) + __builtin_ctzll(word);
+          word &= word - 1;
+        }
+        if (i < count) word = _bitmap[++w];
+      }
+      break;
+    }
+  }
+}
+
+pos_list_t CompactPositionList::materialize() const {
+  pos_list_t result;
+  result.reserve(_size);
+  forEach([&result] (pos_t p) { result.push_back(p); });
+  return result;
+}
+
+size_t CompactPositionList::memoryUsage() const {
+  return sizeof(*this) +
+      _narrow.capacity() * sizeof(uint32_t) +
+      (_bitmap.capacity() + _blockRanks.capacity() + _selectSamples.capacity()) * sizeof(uint64_t);
+}
+
+std::unique_ptr<CompactPositionList> CompactPositionList::copy() const {
+  return std::unique_ptr<CompactPositionList>(new CompactPositionList(*this));
+}
+
+std::unique_ptr<CompactPositionList> CompactPositionList::intersect(const CompactPositionList& left, const CompactPositionList& right) {
+  const auto l = left._representation, r = right._representation;
+
+  if (l == Representation::Range && r == Representation::Range) {
+    const pos_t first = std::max(left._first, right._first);
+    const pos_t last = std::min(left._first + left._size, right._first + right._size);
+    return fromRange(first, last > first ? last - first : 0);
+  }
+
+  if (l == Representation::Bitmap && r == Representation::Bitmap) {
+    std::vector<uint64_t> words(std::min(left._bitmap.size(), right._bitmap.size()));
+    for (size_t w = 0, e = words.size(); w < e; ++w) {
+      words[w] = left._bitmap[w] & right._bitmap[w];
+    }
+    return buildBitmap(std::move(words));
+  }
+
+  if ((l == Representation::Range && r == Representation::Bitmap) ||
+      (l == Representation::Bitmap && r == Representation::Range)) {
+    const auto& range = (l == Representation::Range) ? left : right;
+    const auto& bitmap = (l == Representation::Range) ? right : left;
+
+    const size_t last = std::min(range._first + range._size, bitmap._bitmap.size() * 64);
+    if (last <= range._first) {
+      return fromRange(0, 0);
+    }
+
+    std::vector<uint64_t> words(wordsFor(last), 0);
+    for (size_t w = range._first >> 6, e = words.size(); w < e; ++w) {
+      words[w] = bitmap._bitmap[w];
+    }
+    // clear the bits outside of the range in the boundary words
+    words[range._first >> 6] &= ~0ull << (range._first & 63);
+    if (last & 63) words.back() &= (1ull << (last & 63)) - 1;
+    return buildBitmap(std::move(words));
+  }
+
+  return nullptr;
+}
+
+std::unique_ptr<CompactPositionList> CompactPositionList::unite(const CompactPositionList& left, const CompactPositionList& right) {
+  const auto l = left._representation, r = right._representation;
+
+  if (l == Representation::Range && r == Representation::Range) {
+    const pos_t first = std::max(left._first, right._first);
+    const pos_t last = std::min(left._first + left._size, right._first + right._size);
+    // only overlapping or adjacent ranges form a single range
+    if (first <= last) {
+      const pos_t begin = std::min(left._first, right._first);
+      return fromRange(begin, std::max(left._first + left._size, right._first + right._size) - begin);
+    }
+    return nullptr;
+  }
+
+  if (l == Representation::Bitmap && r == Representation::Bitmap) {
+    const auto& larger = left._bitmap.size() >= right._bitmap.size() ? left : right;
+    const auto& smaller = left._bitmap.size() >= right._bitmap.size() ? right : left;
+    std::vector<uint64_t> words(larger._bitmap);
+    for (size_t w = 0, e = smaller._bitmap.size(); w < e; ++w) {
+      words[w] |= smaller._bitmap[w];
+    }
+    return buildBitmap(std::move(words));
+  }
+
+  if ((l == Representation::Range && r == Representation::Bitmap) ||
+      (l == Representation::Bitmap && r == Representation::Range)) {
+    const auto& range = (l == Representation::Range) ? left : right;
+    const auto& bitmap = (l == Representation::Range) ? right : left;
+
+    std::vector<uint64_t> words(bitmap._bitmap);
+    words.resize(std::max(words.size(), wordsFor(range._first + range._size)), 0);
+    for (pos_t p = range._first, e = range._first + range._size; p < e; ++p) {
+      words[p >> 6] |= 1ull << (p & 63);
+    }
+    return buildBitmap(std::move(words));
+  }
+
+  return nullptr;
+}
+
+PositionListBuilder::PositionListBuilder(size_t universe) :
+    _universe(universe),
+    _useNarrow(universe <= static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1) {}
+
+void PositionListBuilder::push_back(pos_t position) {
+  assert(position < _universe);
+
+  if (_size == 0) {
+    _first = position;
+  } else if (_contiguous && position != _first + _size) {
+    _contiguous = false;
+  }
+  ++_size;
+
+  if (!_bitmap.empty()) {
+    _bitmap[position >> 6] |= 1ull << (position & 63);
+    return;
+  }
+
+  // As long as the positions are contiguous we only count them
+  if (_contiguous) return;
+
+  if (_narrow.empty() && _wide.empty()) {
+    // first gap, store the contiguous prefix explicitly
+    for (pos_t p = _first, e = _first + _size - 1; p < e; ++p) {
+      if (_useNarrow) _narrow.push_back(p); else _wide.push_back(p);
+    }
+  }
+
+  if (_useNarrow) {
+    _narrow.push_back(position);
+  } else {
+    _wide.push_back(position);
+  }
+
+  const size_t listBytes = _useNarrow ? _narrow.size() * sizeof(uint32_t) : _wide.size() * sizeof(pos_t);
+  if (listBytes > bitmapBytes(_universe)) {
+    switchToBitmap();
+  }
+}
+
+void PositionListBuilder::switchToBitmap() {
+  _bitmap.assign(wordsFor(_universe), 0);
+  for (const auto& p : _narrow) _bitmap[p >> 6] |= 1ull << (p & 63);
+  for (const auto& p : _wide) _bitmap[p >> 6] |= 1ull << (p & 63);
+  std::vector<uint32_t>().swap(_narrow);
+  pos_list_t().swap(_wide);
+}
+
+void PositionListBuilder::build(std::unique_ptr<CompactPositionList>& compact, pos_list_t*& wide) {
+  compact.reset();
+  wide = nullptr;
+
+  if (_size < CompactPositionList::minCompactSize) {
+    wide = new pos_list_t;
+    wide->reserve(_size);
+    if (!_bitmap.empty()) {
+      for (size_t w = 0, e = _bitmap.size(); w < e; ++w) {
+        for (uint64_t word = _bitmap[w]; word; word &= word - 1) {
+          wide->push_back((w << 6) + __builtin_ctzll(word));
+        }
+      }
+    } else if (_contiguous) {
+      for (pos_t p = _first, e = _first + _size; p < e; ++p) wide->push_back(p);
+    } else {
+      wide->insert(wide->end(), _narrow.begin(), _narrow.end());
+      wide->insert(wide->end(), _wide.begin(), _wide.end());
+    }
+  } else if (_contiguous) {
+    compact = CompactPositionList::fromRange(_first, _size);
+  } else if (!_bitmap.empty()) {
+    compact = CompactPositionList::buildBitmap(std::move(_bitmap));
+  } else if (_useNarrow) {
+    compact.reset(new CompactPositionList(CompactPositionList::Representation::Narrow));
+    compact->_size = _size;
+    compact->_sorted = true;
+    compact->_narrow = std::move(_narrow);
+    compact->_narrow.shrink_to_fit();
+  } else {
+    wide = new pos_list_t(std::move(_wide));
+  }
+}
+
+} } // namespace hyrise::storage
+
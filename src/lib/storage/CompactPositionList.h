@@ -0,0 +1,157 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Immutable, memory efficient alternative to pos_list_t for the positions
+ * of a PointerCalculator. Depending on the shape and density of the
+ * positions they are stored as
+ *
+ *  - Range:  a single run [first, first + size) of contiguous positions
+ *  - Narrow: 32 bit positions, for positions below 4B (order preserving)
+ *  - Bitmap: one bit per row up to the largest position, for dense and
+ *            strictly increasing positions
+ *
+ * Range and bitmap lists are always sorted, narrow lists keep the order
+ * of their input.
+ */
+class CompactPositionList {
+ public:
+  enum class Representation { Range, Narrow, Bitmap };
+
+  // Lists with less positions are not worth the compaction pass
+  static const size_t minCompactSize = 1024;
+
+  /*
+   * Returns the smallest representation of the given positions or
+   * nullptr if a plain pos_list_t is the best choice.
+   */
+  static std::unique_ptr<CompactPositionList> compact(const pos_list_t& positions);
+  static std::unique_ptr<CompactPositionList> fromRange(pos_t first, size_t size);
+
+  /*
+   * Set operations on two sorted compact lists, return nullptr if the
+   * combination of representations is not handled natively and the
+   * caller has to fall back to merging materialized lists.
+   */
+  static std::unique_ptr<CompactPositionList> intersect(const CompactPositionList& left, const CompactPositionList& right);
+  static std::unique_ptr<CompactPositionList> unite(const CompactPositionList& left, const CompactPositionList& right);
+
+  Representation representation() const { return _representation; }
+  size_t size() const { return _size; }
+  bool isSorted() const { return _representation != Representation::Narrow || _sorted; }
+
+  // Random access to the index-th position
+  pos_t at(const size_t index) const {
+    switch (_representation) {
+      case Representation::Range: return _first + index;
+      case Representation::Narrow: return _narrow[index];
+      default: return select(index);
+    }
+  }
+
+  // Calls func for every position in list order
+  template <typename F>
+  void forEach(F func) const {
+    switch (_representation) {
+      case Representation::Range:
+        for (pos_t p = _first, e = _first + _size; p < e; ++p) func(p);
+        break;
+      case Representation::Narrow:
+        for (const auto& p : _narrow) func(static_cast<pos_t>(p));
+        break;
+      case Representation::Bitmap:
+        for (size_t w = 0, e = _bitmap.size(); w < e; ++w) {
+          uint64_t word = _bitmap[w];
+          while (word) {
+            func(static_cast<pos_t>((w << 6) + __builtin_ctzll(word)));
+            word &= word - 1;
+          }
+        }
+        break;
+    }
+  }
+
+  // Writes the positions at [index, index + count) to buffer, bitmaps are
+  // only searched for the first position and then scanned sequentially
+  void copyTo(size_t index, size_t count, pos_t *buffer) const;
+
+  pos_list_t materialize() const;
+
+  // Approximate number of bytes held by this list
+  size_t memoryUsage() const;
+
+  std::unique_ptr<CompactPositionList> copy() const;
+
+ private:
+  friend class PositionListBuilder;
+
+  explicit CompactPositionList(Representation r);
+
+  static std::unique_ptr<CompactPositionList> buildBitmap(std::vector<uint64_t> words);
+  void buildDirectory();
+  pos_t select(size_t index) const;
+
+  Representation _representation;
+  size_t _size = 0;
+
+  // Range
+  pos_t _first = 0;
+
+  // Narrow
+  std::vector<uint32_t> _narrow;
+  bool _sorted = false;
+
+  // Bitmap, with the number of set bits preceeding every block of
+  // blockWords words and the block holding every sampleRate-th bit
+  static const size_t blockWords = 8;
+  static const size_t sampleRate = 256;
+  std::vector<uint64_t> _bitmap;
+  std::vector<uint64_t> _blockRanks;
+  std::vector<uint64_t> _selectSamples;
+};
+
+/*
+ * Collects strictly increasing positions, e.g. the matches of a scan, and
+ * switches from 32 bit positions to a bitmap as soon as the bitmap becomes
+ * the smaller representation. This bounds the peak memory of a scan by the
+ * size of the bitmap instead of 8 bytes per match.
+ */
+class PositionListBuilder {
+ public:
+  // All positions must be smaller than universe
+  explicit PositionListBuilder(size_t universe);
+
+  void push_back(pos_t position);
+  size_t size() const { return _size; }
+
+  /*
+   * Finishes building. Small lists are returned as pos_list_t in wide,
+   * everything else as compact list. Exactly one of both is set.
+   */
+  void build(std::unique_ptr<CompactPositionList>& compact, pos_list_t*& wide);
+
+ private:
+  void switchToBitmap();
+
+  size_t _universe;
+  size_t _size = 0;
+  pos_t _first = 0;
+  bool _contiguous = true;
+  bool _useNarrow;
+
+  std::vector<uint32_t> _narrow;
+  pos_list_t _wide;
+  std::vector<uint64_t> _bitmap;
+};
+
+} } // namespace hyrise::storage
+
@@ -41,6 +41,20 @@ class FixedLengthVector : public AbstractFixedLengthVector<T> {
     return getRef(column, row);
   }
 
+  virtual void getRange(size_t column, size_t row, size_t count, T *buffer) const override {
+    const T* values = _values.data() + row * _columns + column;
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = values[i * _columns];
+    }
+  }
+
+  virtual void getAt(size_t column, const size_t *rows, size_t count, T *buffer) const override {
+    const T* values = _values.data() + column;
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = values[rows[i] * _columns];
+    }
+  }
+
   virtual const T& getRef(size_t column, size_t row) const override {
     check_access(column, row);
     return _values[row * _columns + column];
@@ -114,6 +114,14 @@ ValueId MutableVerticalTable::getValueId(const size_t column, const size_t row)
   return containerAt(column)->getValueId(tmp, row);
 }
 
+void MutableVerticalTable::getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const {
+  containerAt(column)->getValueIdRange(offset_in_container[column], row, count, buffer);
+}
+
+void MutableVerticalTable::getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const {
+  containerAt(column)->getValueIdsAt(offset_in_container[column], rows, count, buffer);
+}
+
 void MutableVerticalTable::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   containerAt(column)->setValueId(offset_in_container[column], row, valueId);
 }
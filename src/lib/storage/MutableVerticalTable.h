@@ -44,6 +44,8 @@ public:
   size_t size() const override;
   size_t columnCount() const override;
   ValueId getValueId(size_t column, size_t row) const override;
+  void getValueIdRange(size_t column, size_t row, size_t count, ValueId *buffer) const override;
+  void getValueIdsAt(size_t column, const pos_t *rows, size_t count, ValueId *buffer) const override;
   void setValueId(size_t column, size_t row, ValueId valueId) override;
   void reserve(size_t nr_of_values) override;
   void resize(size_t rows) override;
@@ -1,13 +1,14 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "storage/PointerCalculator.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <unordered_set>
 
 #include "helper/make_unique.h"
 #include "helper/checked_cast.h"
-#include "helper/PositionsIntersect.h"
+#include "helper/PositionsSetOperations.h"
 
 #include "storage/PrettyPrinter.h"
 #include "storage/Store.h"
@@ -23,16 +24,22 @@ T* copy_vec(T* orig) {
 }
 
 void PointerCalculator::unnest() {
+  // positions relative to a nested table have to be rewritten
+  if (_compact && (std::dynamic_pointer_cast<const PointerCalculator>(table) ||
+                   std::dynamic_pointer_cast<const TableRangeView>(table))) {
+    decompact();
+  }
+
   // prevent nested pos_list/fields: if the input table is a
   // PointerCalculator instance, combine the old and new
   // pos_list/fields lists
   if (auto p = std::dynamic_pointer_cast<const PointerCalculator>(table)) {
 
     // if our actual table is a PC, we have to unfold the positions
-    if (pos_list != nullptr && p->pos_list != nullptr) {
+    if (pos_list != nullptr && p->hasPositions()) {
       auto tmp_list = new pos_list_t(pos_list->size());
       std::transform(std::begin(*(pos_list)), std::end(*(pos_list)), std::begin(*tmp_list), [p](const pos_t& i) -> pos_t {
-	  return p->pos_list->at(i);
+	  return p->positionAt(i);
 	});
       table = p->table;
       std::swap(pos_list, tmp_list);
@@ -63,22 +70,60 @@ void PointerCalculator::unnest() {
 
 PointerCalculator::PointerCalculator(c_atable_ptr_t t, pos_list_t *pos, field_list_t *f) : table(t), pos_list(pos), fields(f) {
   unnest();
+  compact();
   updateFieldMapping();
 }
 
 PointerCalculator::PointerCalculator(const PointerCalculator& other) : table(other.table), pos_list(copy_vec(other.pos_list)), fields(copy_vec(other.fields)) {
+  if (other._compact) {
+    _compact = other._compact->copy();
+  }
   updateFieldMapping();
 }
 
 atable_ptr_t PointerCalculator::copy() const {
-  return create(table, fields, pos_list);
+  return std::make_shared<PointerCalculator>(*this);
 }
 
 PointerCalculator::PointerCalculator(c_atable_ptr_t t, pos_list_t pos) : table(t), pos_list(new pos_list_t(std::move(pos))) {
   unnest();
+  compact();
+  updateFieldMapping();
+}
+
+PointerCalculator::PointerCalculator(c_atable_ptr_t t, PositionListBuilder positions, field_list_t *f) : table(t), pos_list(nullptr), fields(f) {
+  positions.build(_compact, pos_list);
+  unnest();
+  compact();
   updateFieldMapping();
 }
 
+PointerCalculator::PointerCalculator(c_atable_ptr_t t, std::unique_ptr<CompactPositionList> positions, field_list_t *f) : table(t), pos_list(nullptr), fields(f), _compact(std::move(positions)) {
+  unnest();
+  compact();
+  updateFieldMapping();
+}
+
+void PointerCalculator::compact() {
+  if (pos_list == nullptr) {
+    return;
+  }
+
+  if (auto compact_positions = CompactPositionList::compact(*pos_list)) {
+    _compact = std::move(compact_positions);
+    delete pos_list;
+    pos_list = nullptr;
+  }
+}
+
+void PointerCalculator::decompact() {
+  if (_compact) {
+    pos_list = _materialized ? _materialized.release() : new pos_list_t(_compact->materialize());
+    _compact.reset();
+  }
+  _materialized.reset();
+}
+
 PointerCalculator::~PointerCalculator() {
   delete fields;
   delete pos_list;
@@ -128,6 +173,8 @@ void PointerCalculator::updateFieldMapping() {
 void PointerCalculator::setPositions(const pos_list_t pos) {
   if (pos_list != nullptr)
     delete pos_list;
+  _compact.reset();
+  _materialized.reset();
   pos_list = new std::vector<pos_t>(pos);
 }
 
@@ -170,8 +217,8 @@ const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryAt(const
     actual_column = column;
   }
 
-  if (pos_list && pos_list->size() > 0) {
-    actual_row = pos_list->at(row);
+  if (hasPositions() && size() > 0) {
+    actual_row = positionAt(row);
   } else {
     actual_row = row;
   }
@@ -192,6 +239,10 @@ const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryByTableId
 }
 
 size_t PointerCalculator::size() const {
+  if (_compact) {
+    return _compact->size();
+  }
+
   if (pos_list) {
     return pos_list->size();
   }
@@ -210,8 +261,8 @@ size_t PointerCalculator::columnCount() const {
 ValueId PointerCalculator::getValueId(const size_t column, const size_t row) const {
   size_t actual_column, actual_row;
 
-  if (pos_list) {
-    actual_row = pos_list->at(row);
+  if (hasPositions()) {
+    actual_row = positionAt(row);
   } else {
     actual_row = row;
   }
@@ -225,6 +276,45 @@ ValueId PointerCalculator::getValueId(const size_t column, const size_t row) con
   return table->getValueId(actual_column, actual_row);
 }
 
+void PointerCalculator::getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const {
+  const size_t actual_column = fields ? fields->at(column) : column;
+
+  // Contiguous rows of the underlying table are read as a range, explicit
+  // positions are handed down as a whole
+  if (!hasPositions()) {
+    table->getValueIdRange(actual_column, row, count, buffer);
+  } else if (pos_list) {
+    table->getValueIdsAt(actual_column, pos_list->data() + row, count, buffer);
+  } else if (_compact->representation() == CompactPositionList::Representation::Range) {
+    table->getValueIdRange(actual_column, _compact->at(row), count, buffer);
+  } else {
+    pos_t actual_rows[valueBatchSize];
+    for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+      const size_t n = std::min(valueBatchSize, count - offset);
+      _compact->copyTo(row + offset, n, actual_rows);
+      table->getValueIdsAt(actual_column, actual_rows, n, buffer + offset);
+    }
+  }
+}
+
+void PointerCalculator::getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const {
+  const size_t actual_column = fields ? fields->at(column) : column;
+
+  if (!hasPositions()) {
+    table->getValueIdsAt(actual_column, rows, count, buffer);
+    return;
+  }
+
+  pos_t actual_rows[valueBatchSize];
+  for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+    const size_t n = std::min(valueBatchSize, count - offset);
+    for (size_t i = 0; i < n; ++i) {
+      actual_rows[i] = positionAt(rows[offset + i]);
+    }
+    table->getValueIdsAt(actual_column, actual_rows, n, buffer + offset);
+  }
+}
+
 unsigned PointerCalculator::partitionCount() const {
   return slice_count;
 }
@@ -247,8 +337,8 @@ size_t PointerCalculator::getTableRowForRow(const size_t row) const
 {
   size_t actual_row;
   // resolve mapping of THIS pointer calculator
-  if (pos_list) {
-    actual_row = pos_list->at(row);
+  if (hasPositions()) {
+    actual_row = positionAt(row);
   } else {
     actual_row = row;
   }
@@ -291,20 +381,32 @@ c_atable_ptr_t PointerCalculator::getActualTable() const {
 }
 
 const pos_list_t *PointerCalculator::getPositions() const {
+  if (_compact) {
+    std::lock_guard<std::mutex> lock(_materializeMutex);
+    if (!_materialized) {
+      _materialized.reset(new pos_list_t(_compact->materialize()));
+    }
+    return _materialized.get();
+  }
   return pos_list;
 }
 
+const CompactPositionList *PointerCalculator::getCompactPositions() const {
+  return _compact.get();
+}
+
 pos_list_t PointerCalculator::getActualTablePositions() const {
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(table);
+  const auto* own_positions = getPositions();
 
   if (!p) {
-    return *pos_list;
+    return *own_positions;
   }
 
-  pos_list_t result(pos_list->size());
+  pos_list_t result(own_positions->size());
   pos_list_t positions = p->getActualTablePositions();
 
-  for (pos_list_t::const_iterator it = pos_list->begin(); it != pos_list->end(); ++it) {
+  for (pos_list_t::const_iterator it = own_positions->begin(); it != own_positions->end(); ++it) {
     result.push_back(positions[*it]);
   }
 
@@ -345,17 +447,22 @@ atable_ptr_t PointerCalculator::copy_structure(const field_list_t *fields, const
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::intersect(const std::shared_ptr<const PointerCalculator>& other) const {
+  assert((other->table == this->table) && "Should point to same table");
+
+  if (_compact && other->_compact) {
+    if (auto compact_result = CompactPositionList::intersect(*_compact, *other->_compact)) {
+      return create(table, std::move(compact_result), copy_vec(fields));
+    }
+  }
+
+  const auto* left = getPositions();
+  const auto* right = other->getPositions();
   pos_list_t *result = new pos_list_t();
-  result->reserve(std::max(pos_list->size(), other->pos_list->size()));
-  assert(std::is_sorted(begin(*pos_list), end(*pos_list)) && std::is_sorted(begin(*other->pos_list), end(*other->pos_list)) && "Both lists have to be sorted");
-  
-  intersect_pos_list(
-    pos_list->begin(), pos_list->end(),
-    other->pos_list->begin(), other->pos_list->end(),
-    std::back_inserter(*result));
+  assert(std::is_sorted(begin(*left), end(*left)) && std::is_sorted(begin(*right), end(*right)) && "Both lists have to be sorted");
 
-  assert((other->table == this->table) && "Should point to same table");
-  return create(table, result, fields);
+  helper::intersect_sorted(*left, *right, *result);
+
+  return create(table, result, copy_vec(fields));
 }
 
 
@@ -366,7 +473,7 @@ bool PointerCalculator::isSmaller( std::shared_ptr<const PointerCalculator> lx,
 std::shared_ptr<const PointerCalculator> PointerCalculator::intersect_many(pc_vector::iterator it, pc_vector::iterator it_end) {
   std::sort(it, it_end, PointerCalculator::isSmaller);
   std::shared_ptr<const PointerCalculator> base = *(it++);
-  for (;it != it_end; ++it) {
+  for (;it != it_end && base->size() > 0; ++it) {
     base = base->intersect(*it);
   }
   return base;
@@ -374,19 +481,27 @@ std::shared_ptr<const PointerCalculator> PointerCalculator::intersect_many(pc_ve
 
 std::shared_ptr<PointerCalculator> PointerCalculator::unite(const std::shared_ptr<const PointerCalculator>& other) const {
   assert((other->table == this->table) && "Should point to same table");
-  if (pos_list && other->pos_list) {
+  if (hasPositions() && other->hasPositions()) {
+    if (_compact && other->_compact) {
+      if (auto compact_result = CompactPositionList::unite(*_compact, *other->_compact)) {
+        return create(table, std::move(compact_result), copy_vec(fields));
+      }
+    }
+
+    const auto* left = getPositions();
+    const auto* right = other->getPositions();
     auto result = new pos_list_t();
-    result->reserve(pos_list->size() + other->pos_list->size());
-    assert(std::is_sorted(begin(*pos_list), end(*pos_list)) && std::is_sorted(begin(*other->pos_list), end(*other->pos_list)) && "Both lists have to be sorted");
-    std::set_union(pos_list->begin(), pos_list->end(),
-                   other->pos_list->begin(), other->pos_list->end(),
-                   std::back_inserter(*result));
+    assert(std::is_sorted(begin(*left), end(*left)) && std::is_sorted(begin(*right), end(*right)) && "Both lists have to be sorted");
+    helper::unite_sorted(*left, *right, *result);
     return create(table, result, copy_vec(fields));
   } else {
-    pos_list_t* positions = nullptr;
-    if (pos_list == nullptr) { positions = other->pos_list; }
-    if (other->pos_list == nullptr) { positions = pos_list; }
-    return create(table, copy_vec(positions), copy_vec(fields));
+    const PointerCalculator* source = nullptr;
+    if (!hasPositions()) { source = other.get(); }
+    if (!other->hasPositions()) { source = this; }
+    if (source->_compact) {
+      return create(table, source->_compact->copy(), copy_vec(fields));
+    }
+    return create(table, copy_vec(source->pos_list), copy_vec(fields));
   }
 }
 
@@ -397,11 +512,21 @@ std::shared_ptr<PointerCalculator> PointerCalculator::concatenate(const std::sha
 }
 
 std::shared_ptr<const PointerCalculator> PointerCalculator::unite_many(pc_vector::const_iterator it, pc_vector::const_iterator it_end){
-  std::shared_ptr<const PointerCalculator> base = *(it++);
-  for (;it != it_end; ++it) {
-    base = base->unite(*it);
+  // unite pairwise in rounds, so that every position is merged
+  // log(n) instead of n times
+  pc_vector round(it, it_end);
+  while (round.size() > 1) {
+    pc_vector next;
+    next.reserve((round.size() + 1) / 2);
+    for (size_t i = 0; i + 1 < round.size(); i += 2) {
+      next.push_back(round[i]->unite(round[i + 1]));
+    }
+    if (round.size() % 2 == 1) {
+      next.push_back(round.back());
+    }
+    round.swap(next);
   }
-  return base;
+  return round.front();
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::concatenate_many(pc_vector::const_iterator it, pc_vector::const_iterator it_end) {
@@ -416,7 +541,9 @@ std::shared_ptr<PointerCalculator> PointerCalculator::concatenate_many(pc_vector
       table = (*it)->table;
     }
 
-    if (pl == nullptr) {
+    if ((*it)->_compact) {
+      (*it)->_compact->forEach([result] (pos_t p) { result->push_back(p); });
+    } else if (pl == nullptr) {
       auto sz = (*it)->size();
       result->resize(result->size() + sz);
       std::iota(end(*result)-sz, end(*result), 0);
@@ -436,14 +563,17 @@ void PointerCalculator::debugStructure(size_t level) const {
 
 void PointerCalculator::validate(tx::transaction_id_t tid, tx::transaction_id_t cid) {
   const auto& store = checked_pointer_cast<const Store>(table);
-  if (pos_list == nullptr) {
+  if (!hasPositions()) {
     pos_list = new pos_list_t(store->buildValidPositions(cid, tid));
   } else {
+    decompact();
     store->validatePositions(*pos_list, cid, tid);
   }
+  compact();
 }
 
 void PointerCalculator::remove(const pos_list_t& pl) {
+  decompact();
   std::unordered_set<pos_t> tmp(pl.begin(), pl.end());
   const auto& end = tmp.cend();
   auto res = std::remove_if(std::begin(*pos_list), std::end(*pos_list),[&tmp, &end](const pos_t& p){
@@ -3,11 +3,13 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "helper/types.h"
 #include "helper/SharedFactory.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/CompactPositionList.h"
 #include "storage/MutableVerticalTable.h"
 
 namespace hyrise {
@@ -21,12 +23,32 @@ class PointerCalculator : public AbstractTable,
   */
   void unnest();
 
+  /**
+  * Replaces the position list with a compact representation if possible
+  */
+  void compact();
+
+  /**
+  * Turns compact positions back into a modifiable position list
+  */
+  void decompact();
+
+  bool hasPositions() const {
+    return pos_list != nullptr || _compact;
+  }
+
+  pos_t positionAt(const size_t row) const {
+    return _compact ? _compact->at(row) : pos_list->at(row);
+  }
+
 public:
 
   PointerCalculator(c_atable_ptr_t t, pos_list_t *pos = nullptr, field_list_t *f = nullptr);
   PointerCalculator(const PointerCalculator& other);
   
   PointerCalculator(c_atable_ptr_t t, pos_list_t pos);
+  PointerCalculator(c_atable_ptr_t t, PositionListBuilder positions, field_list_t *f = nullptr);
+  PointerCalculator(c_atable_ptr_t t, std::unique_ptr<CompactPositionList> positions, field_list_t *f = nullptr);
 
   virtual ~PointerCalculator();
 
@@ -43,7 +65,15 @@ public:
   static std::shared_ptr<PointerCalculator> concatenate_many(pc_vector::const_iterator it, pc_vector::const_iterator it_end);
   static bool isSmaller( std::shared_ptr<const PointerCalculator> lx, std::shared_ptr<const PointerCalculator> rx );
 
+  /**
+  * Returns the positions as pos_list_t. For compact positions the list is
+  * materialized on first access and kept until the positions change.
+  */
   const pos_list_t *getPositions() const;
+
+  // Compact representation of the positions or nullptr if a plain list is used
+  const CompactPositionList *getCompactPositions() const;
+
   pos_list_t getActualTablePositions() const;
 
   size_t getTableRowForRow(const size_t row) const;
@@ -78,6 +108,8 @@ public:
   size_t size() const override;
   size_t columnCount() const override;
   ValueId getValueId(const size_t column, const size_t row) const override;
+  void getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const override;
+  void getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const override;
   unsigned partitionCount() const override;
   size_t partitionWidth(const size_t slice) const override;
   void print(const size_t limit = (size_t) -1) const override;
@@ -90,6 +122,11 @@ public:
   pos_list_t *pos_list;
   field_list_t *fields;
 
+  // Alternative to pos_list, at most one of both is set
+  std::unique_ptr<CompactPositionList> _compact;
+  mutable std::unique_ptr<pos_list_t> _materialized;
+  mutable std::mutex _materializeMutex;
+
   // Vector mapping the renaed field names
   std::unique_ptr<std::vector<ColumnMetadata>> _renamed;
 
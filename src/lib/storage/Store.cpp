@@ -1,5 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/Store.h>
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 #include <io/TransactionManager.h>
@@ -81,6 +83,72 @@ void Store::merge() {
   _delta_size = new_delta->size();
 }
 
+size_t Store::compactDelta(tx::transaction_cid_t oldest_snapshot, size_t min_rows) {
+  auto& txmgr = tx::TransactionManager::getInstance();
+  const size_t main_size = _main_table->size();
+  const size_t delta_size = delta->size();
+
+  // Running transactions keep the positions of their rows, TID 0 marks
+  // rows a transaction inserted and deleted itself
+  const bool running = txmgr.hasRunningTransactions();
+  auto owned = [&txmgr, running] (tx::transaction_id_t tid) {
+    return tid != tx::START_TID && (tid == tx::UNKNOWN ? running : txmgr.isRunning(tid));
+  };
+
+  pos_list_t kept;
+  kept.reserve(delta_size);
+  for (size_t row = 0; row < delta_size; ++row) {
+    const size_t pos = main_size + row;
+    if (owned(_tidVector[pos])) {
+      return 0;
+    }
+    if (_cidBeginVector[pos] != tx::INF_CID && _cidEndVector[pos] > oldest_snapshot) {
+      kept.push_back(row);
+    }
+  }
+  const size_t removed = delta_size - kept.size();
+  if (removed == 0 || removed < min_rows) {
+    return 0;
+  }
+
+  // The validity vectors are replaced as a whole, a rollback still
+  // unlocking rows of the main would lose its writes
+  for (size_t pos = 0; pos < main_size; ++pos) {
+    if (_tidVector[pos] != tx::START_TID && txmgr.isRunning(_tidVector[pos])) {
+      return 0;
+    }
+  }
+
+  // The delta dictionaries are unsorted and keep their value ids
+  atable_ptr_t new_delta = delta->copy_structure(create_concurrent_dict, create_concurrent_storage);
+  for (size_t column = 0; column < delta->columnCount(); ++column) {
+    new_delta->setDictionaryAt(delta->dictionaryAt(column), column);
+  }
+  new_delta->resize(kept.size());
+  std::vector<ValueId> valueIds(kept.size());
+  for (size_t column = 0; column < delta->columnCount(); ++column) {
+    delta->getValueIdsAt(column, kept.data(), kept.size(), valueIds.data());
+    for (size_t row = 0; row < kept.size(); ++row) {
+      new_delta->setValueId(column, row, valueIds[row]);
+    }
+  }
+
+  tbb::concurrent_vector<tx::transaction_cid_t> cidBegin(_cidBeginVector.begin(), _cidBeginVector.begin() + main_size);
+  tbb::concurrent_vector<tx::transaction_cid_t> cidEnd(_cidEndVector.begin(), _cidEndVector.begin() + main_size);
+  tbb::concurrent_vector<tx::transaction_id_t> tids(_tidVector.begin(), _tidVector.begin() + main_size);
+  for (const auto& row : kept) {
+    cidBegin.push_back(_cidBeginVector[main_size + row]);
+    cidEnd.push_back(_cidEndVector[main_size + row]);
+    tids.push_back(_tidVector[main_size + row]);
+  }
+  _cidBeginVector.swap(cidBegin);
+  _cidEndVector.swap(cidEnd);
+  _tidVector.swap(tids);
+
+  delta = new_delta;
+  _delta_size = kept.size();
+  return removed;
+}
 
 atable_ptr_t Store::getMainTable() const {
   return _main_table;
@@ -142,6 +210,48 @@ ValueId Store::getValueId(const size_t column, const size_t row) const {
   return valueId;
 }
 
+void Store::getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const {
+  const size_t offset = _main_table->size();
+  const size_t end = row + count;
+  assert(end <= offset + delta->size());
+
+  // rows before the offset are read from the main, the rest from the delta
+  const size_t main_count = (row < offset) ? std::min(end, offset) - row : 0;
+  if (main_count > 0) {
+    _main_table->getValueIdRange(column, row, main_count, buffer);
+  }
+  if (main_count < count) {
+    delta->getValueIdRange(column, row + main_count - offset, count - main_count, buffer + main_count);
+    for (size_t i = main_count; i < count; ++i) {
+      buffer[i].table = 1;
+    }
+  }
+}
+
+void Store::getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const {
+  const size_t offset = _main_table->size();
+  pos_t delta_rows[valueBatchSize];
+
+  // Read each run of rows located in the same table with one call
+  size_t i = 0;
+  while (i < count) {
+    size_t run = i;
+    if (rows[i] < offset) {
+      while (run < count && rows[run] < offset) ++run;
+      _main_table->getValueIdsAt(column, rows + i, run - i, buffer + i);
+    } else {
+      while (run < count && rows[run] >= offset && run - i < valueBatchSize) {
+        delta_rows[run - i] = rows[run] - offset;
+        ++run;
+      }
+      delta->getValueIdsAt(column, delta_rows, run - i, buffer + i);
+      for (size_t j = i; j < run; ++j) {
+        buffer[j].table = 1;
+      }
+    }
+    i = run;
+  }
+}
 
 size_t Store::size() const {
   return _main_table->size() + delta->size();
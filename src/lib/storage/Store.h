@@ -41,6 +41,15 @@ public:
   size_t deltaOffset() const;
   void merge();
 
+  /// Removes the delta rows no snapshot newer than oldest_snapshot can
+  /// see: rows whose deletion committed at or before it and rows of
+  /// transactions that ended without committing. The remaining delta
+  /// rows move to the front, so nothing may access the store meanwhile.
+  /// Nothing is removed while running transactions own delta rows or
+  /// fewer than min_rows rows are reclaimable.
+  /// @returns the number of removed rows
+  size_t compactDelta(tx::transaction_cid_t oldest_snapshot, size_t min_rows = 1);
+
   /// Replaces the merger used for merging main tables with delta.
   /// @param _merger Pointer to a merger instance.
   void setMerger(TableMerger *_merger);
@@ -79,6 +88,8 @@ public:
   const AbstractTable::SharedDictionaryPtr& dictionaryAt(size_t column, size_t row = 0, table_id_t table_id = 0) const override;
   const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(size_t column, table_id_t table_id) const override;
   ValueId getValueId(size_t column, size_t row) const override;
+  void getValueIdRange(size_t column, size_t row, size_t count, ValueId *buffer) const override;
+  void getValueIdsAt(size_t column, const pos_t *rows, size_t count, ValueId *buffer) const override;
   void setValueId(size_t column, size_t row, ValueId vid) override;
   size_t size() const override;
   size_t columnCount() const override;
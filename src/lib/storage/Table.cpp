@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "storage/Table.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -173,6 +174,32 @@ ValueId Table::getValueId(const size_t column, const size_t row) const {
 }
 
 
+void Table::getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const {
+  assert(column < width);
+  value_id_t valueIds[valueBatchSize];
+  for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+    const size_t n = std::min(valueBatchSize, count - offset);
+    tuples->getRange(column, row + offset, n, valueIds);
+    for (size_t i = 0; i < n; ++i) {
+      buffer[offset + i] = ValueId(valueIds[i], 0);
+    }
+  }
+}
+
+
+void Table::getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const {
+  assert(column < width);
+  value_id_t valueIds[valueBatchSize];
+  for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+    const size_t n = std::min(valueBatchSize, count - offset);
+    tuples->getAt(column, rows + offset, n, valueIds);
+    for (size_t i = 0; i < n; ++i) {
+      buffer[offset + i] = ValueId(valueIds[i], 0);
+    }
+  }
+}
+
+
 void Table::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   assert(column < width);
   tuples->set(column, row, valueId.valueId);
@@ -87,6 +87,10 @@ public:
 
   ValueId getValueId(const size_t column, const size_t row) const;
 
+  void getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const override;
+
+  void getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const override;
+
   void setValueId(const size_t column, const size_t row, const ValueId valueId);
 
   void reserve(const size_t nr_of_values);
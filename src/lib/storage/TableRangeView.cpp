@@ -10,6 +10,7 @@
 #include "storage/PrettyPrinter.h"
 #include "storage/ColumnMetadata.h"
 
+#include <algorithm>
 #include <iostream>
 namespace hyrise { namespace storage {
 
@@ -57,6 +58,26 @@ ValueId TableRangeView::getValueId(const size_t column, const size_t row) const{
   return _table->getValueId(column, actual_row);
 }
 
+void TableRangeView::getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const {
+  _table->getValueIdRange(column, row + _start, count, buffer);
+}
+
+void TableRangeView::getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const {
+  if (_start == 0) {
+    _table->getValueIdsAt(column, rows, count, buffer);
+    return;
+  }
+
+  pos_t actual_rows[valueBatchSize];
+  for (size_t offset = 0; offset < count; offset += valueBatchSize) {
+    const size_t n = std::min(valueBatchSize, count - offset);
+    for (size_t i = 0; i < n; ++i) {
+      actual_rows[i] = rows[offset + i] + _start;
+    }
+    _table->getValueIdsAt(column, actual_rows, n, buffer + offset);
+  }
+}
+
 size_t TableRangeView::partitionWidth(const size_t slice) const{
   return _table->partitionWidth(slice);
 }
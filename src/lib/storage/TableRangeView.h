@@ -42,6 +42,8 @@ public:
   size_t size() const;
   void setValueId(const size_t column, const size_t row, const ValueId valueId);
   ValueId getValueId(const size_t column, const size_t row) const;
+  void getValueIdRange(const size_t column, const size_t row, const size_t count, ValueId *buffer) const override;
+  void getValueIdsAt(const size_t column, const pos_t *rows, const size_t count, ValueId *buffer) const override;
 
   const ColumnMetadata& metadataAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0) const override;
 
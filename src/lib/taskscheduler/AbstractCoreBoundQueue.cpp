@@ -35,7 +35,7 @@ void AbstractCoreBoundQueue::join() {
   _thread->join();
 }
 
-void AbstractCoreBoundQueue::launchThread(int core) {
+int AbstractCoreBoundQueue::getSystemCore(int core) {
   //get the number of cores on system
   int NUM_PROCS = getNumberOfCoresOnSystem();
 
@@ -43,7 +43,14 @@ void AbstractCoreBoundQueue::launchThread(int core) {
   // and we can only get worse from there thatswhy we use numprocs-1 as the suitable number
   
   const size_t freeCores = std::min(NUM_PROCS - 1, 2);
-  core = (core % (NUM_PROCS - freeCores)) + freeCores;
+  return (core % (NUM_PROCS - freeCores)) + freeCores;
+}
+
+void AbstractCoreBoundQueue::launchThread(int core) {
+  //get the number of cores on system
+  int NUM_PROCS = getNumberOfCoresOnSystem();
+
+  core = getSystemCore(core);
 
   if (core < NUM_PROCS) {
     _thread = new std::thread(&AbstractTaskQueue::executeTask, this);
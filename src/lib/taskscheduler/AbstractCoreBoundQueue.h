@@ -56,6 +56,11 @@ public:
    */
   virtual std::vector<std::shared_ptr<Task> > stopQueue() = 0;
 
+  /*
+   * the core of the system the thread of a queue for the given core is bound to
+   */
+  static int getSystemCore(int core);
+
   // getter/setter
   int getCore() const{
     return _core;
@@ -19,8 +19,15 @@ bool registered  =
     SharedScheduler::registerScheduler<CentralPriorityScheduler>("CentralPriorityScheduler");
 }
 
-CentralPriorityScheduler::CentralPriorityScheduler(int threads) {
+CentralPriorityScheduler::CentralPriorityScheduler(int threads) : CentralPriorityScheduler(threads, true) {}
+
+CentralPriorityScheduler::CentralPriorityScheduler(int threads, bool launch) {
   _status = START_UP;
+  if (launch)
+    launchWorkers(threads);
+}
+
+void CentralPriorityScheduler::launchWorkers(int threads) {
   // create and launch threads
   if(threads > getNumberOfCoresOnSystem()){
     fprintf(stderr, "Tried to use more threads then cores - no binding of threads takes place\n");
@@ -86,31 +93,23 @@ void PriorityWorkerThread::operator()(){
     // lock queue to get task
     std::unique_lock<lock_t> ul(scheduler._queueMutex);
     
-    // get task and execute
-    if (scheduler._runQueue.size() > 0) {
-      std::shared_ptr<Task> task = scheduler._runQueue.top();
-      // get first task
-      scheduler._runQueue.pop();
-
+    // get first task and execute
+    std::shared_ptr<Task> task = scheduler.popReady();
+    if (task) {
       ul.unlock();
-      
-      if (task) {
-        (*task)();
-        LOG4CXX_DEBUG(scheduler._logger, "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec);
-        // notify done observers that task is done
-        task->notifyDoneObservers();
-      }
+
+      (*task)();
+      LOG4CXX_DEBUG(scheduler._logger, "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec);
+      // notify done observers that task is done
+      task->notifyDoneObservers();
     }
     // no task in runQueue -> sleep and wait for new tasks
     else {
-      //if queue still empty go to sleep and wait until new tasks have been arrived
-      if (scheduler._runQueue.size() < 1) {
-        // if thread is about to stop, break execution loop
-        if (scheduler._status != scheduler.RUN)
-          continue;
+      // if thread is about to stop, break execution loop
+      if (scheduler._status != scheduler.RUN)
+        continue;
 
-        scheduler._condition.wait(ul);
-      }
+      scheduler._condition.wait(ul);
     }
   }
 }
@@ -126,7 +125,7 @@ void CentralPriorityScheduler::schedule(std::shared_ptr<Task> task){
   task->lockForNotifications();
   if (task->isReady()){
     std::lock_guard<lock_t> lk(_queueMutex);
-    _runQueue.push(task);
+    pushReady(task);
     _condition.notify_one();
   }
   else {
@@ -138,6 +137,18 @@ void CentralPriorityScheduler::schedule(std::shared_ptr<Task> task){
   task->unlockForNotifications();
 }
 
+void CentralPriorityScheduler::pushReady(const std::shared_ptr<Task> &task) {
+  _runQueue.push(task);
+}
+
+std::shared_ptr<Task> CentralPriorityScheduler::popReady() {
+  if (_runQueue.empty())
+    return nullptr;
+  std::shared_ptr<Task> task = _runQueue.top();
+  _runQueue.pop();
+  return task;
+}
+
 /*
  * shutdown task scheduler; makes sure all underlying threads are stopped
  */
@@ -176,7 +187,7 @@ void CentralPriorityScheduler::notifyReady(std::shared_ptr<Task> task) {
   if (tmp == 1) {
     LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
     std::lock_guard<lock_t> lk(_queueMutex);
-    _runQueue.push(task);
+    pushReady(task);
     _condition.notify_one();
   } else
     // should never happen, but check to identify potential race conditions
@@ -63,6 +63,14 @@ protected:
   static log4cxx::LoggerPtr _logger;
 
 
+  // schedulers with their own run queue launch the workers once they are constructed
+  CentralPriorityScheduler(int threads, bool launch);
+  void launchWorkers(int threads);
+  // adds a ready task to the run queue; called with _queueMutex held
+  virtual void pushReady(const std::shared_ptr<Task> &task);
+  // takes the next task to run from the run queue, nullptr if it is empty; called with _queueMutex held
+  virtual std::shared_ptr<Task> popReady();
+
 public:
   CentralPriorityScheduler(int threads = getNumberOfCoresOnSystem());
   virtual ~CentralPriorityScheduler();
@@ -13,10 +13,13 @@ namespace {
 
 DynamicPriorityScheduler::DynamicPriorityScheduler(int threads):CentralPriorityScheduler(threads){}
 
+DynamicPriorityScheduler::DynamicPriorityScheduler(int threads, bool launch):CentralPriorityScheduler(threads, launch){}
+
 void DynamicPriorityScheduler::schedule(std::shared_ptr<Task> task){
   if (task->isDynamic() && task->isReady()) {
     uint dynamicCount = task->determineDynamicCount(_maxTaskSize);
     auto tasks = task->applyDynamicParallelization(dynamicCount);
+    task->notifyParallelized(tasks, dynamicCount);
     for (const auto& i : tasks) {
       CentralPriorityScheduler::schedule(i);
     }
@@ -37,10 +40,11 @@ void DynamicPriorityScheduler::notifyReady(std::shared_ptr<Task> task){
     if (task->isDynamic()) {
       auto dynamicCount = task->determineDynamicCount(_maxTaskSize);
       auto tasks = task->applyDynamicParallelization(dynamicCount);
+      task->notifyParallelized(tasks, dynamicCount);
       for (const auto& i : tasks) {
         if (i->isReady()) {
           std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
-          _runQueue.push(i);
+          pushReady(i);
           _condition.notify_one();
         } else {   
           i->addReadyObserver(shared_from_this());
@@ -51,7 +55,7 @@ void DynamicPriorityScheduler::notifyReady(std::shared_ptr<Task> task){
       }
     } else { // task is not dynamic
       std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
-      _runQueue.push(task);
+      pushReady(task);
       _condition.notify_one();
     }
   } else {
@@ -20,6 +20,9 @@ public:
     _maxTaskSize = maxTaskSize;
   }
 
+protected:
+  DynamicPriorityScheduler(int threads, bool launch);
+
 private:
   size_t _maxTaskSize = 0;
 };
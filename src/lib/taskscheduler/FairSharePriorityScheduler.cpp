@@ -0,0 +1,147 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "FairSharePriorityScheduler.h"
+#include "SharedScheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hyrise {
+namespace taskscheduler {
+
+// register Scheduler at SharedScheduler
+namespace {
+bool registered  =
+    SharedScheduler::registerScheduler<FairSharePriorityScheduler>("FairSharePriorityScheduler");
+}
+
+const double FairShareQueue::defaultShare = 1.0;
+
+void FairShareQueue::setShare(int priority, double share) {
+  if (share <= 0)
+    throw std::invalid_argument("CPU share of priority " + std::to_string(priority) + " must be positive");
+  _shares[priority] = share;
+}
+
+double FairShareQueue::getShare(int priority) const {
+  auto it = _shares.find(priority);
+  return it == _shares.end() ? defaultShare : it->second;
+}
+
+void FairShareQueue::setAgingThreshold(clock_t::duration threshold) {
+  _agingThreshold = threshold;
+}
+
+void FairShareQueue::push(const std::shared_ptr<Task> &task) {
+  auto inserted = _classes.insert({task->getPriority(), PriorityClass()});
+  auto &priorityClass = inserted.first->second;
+  if (inserted.second)
+    priorityClass.pass = _pass;
+
+  // read-only queries share the transaction id, only the query id tells
+  // them apart; tasks outside of a request fall back to the transaction
+  const int session = task->getSessionId();
+  query_key_t key(session, "");
+  if (session == Task::SESSION_ID_NOT_SET)
+    key.second = task->getQueryId().empty() ? std::to_string(task->getId()) : task->getQueryId();
+  auto query = priorityClass.queries.insert({key, Query()});
+  if (query.second)
+    query.first->second.pass = priorityClass.queryPass;
+
+  query.first->second.tasks.emplace_back(clock_t::now(), task);
+  ++_size;
+}
+
+std::shared_ptr<Task> FairShareQueue::pop() {
+  if (_size == 0)
+    return nullptr;
+
+  if (_agingThreshold > clock_t::duration::zero()) {
+    if (auto task = popAged())
+      return task;
+  }
+
+  // lowest pass wins, ties go to the higher priority
+  auto priorityClass = _classes.begin();
+  for (auto it = _classes.begin(); it != _classes.end(); ++it) {
+    if (it->second.pass < priorityClass->second.pass)
+      priorityClass = it;
+  }
+  auto &queries = priorityClass->second.queries;
+  auto query = queries.begin();
+  for (auto it = queries.begin(); it != queries.end(); ++it) {
+    if (it->second.pass < query->second.pass)
+      query = it;
+  }
+  return take(priorityClass, query);
+}
+
+std::shared_ptr<Task> FairShareQueue::popAged() {
+  // the oldest task of a query is at its front
+  const auto deadline = clock_t::now() - _agingThreshold;
+  auto oldestClass = _classes.end();
+  std::map<query_key_t, Query>::iterator oldestQuery;
+  for (auto priorityClass = _classes.begin(); priorityClass != _classes.end(); ++priorityClass) {
+    auto &queries = priorityClass->second.queries;
+    for (auto query = queries.begin(); query != queries.end(); ++query) {
+      const auto enqueued = query->second.tasks.front().first;
+      if (enqueued <= deadline && (oldestClass == _classes.end() || enqueued < oldestQuery->second.tasks.front().first)) {
+        oldestClass = priorityClass;
+        oldestQuery = query;
+      }
+    }
+  }
+  if (oldestClass == _classes.end())
+    return nullptr;
+  return take(oldestClass, oldestQuery);
+}
+
+std::shared_ptr<Task> FairShareQueue::take(std::map<int, PriorityClass>::iterator priorityClass,
+                                           std::map<query_key_t, Query>::iterator query) {
+  auto task = query->second.tasks.front().second;
+  query->second.tasks.pop_front();
+  --_size;
+
+  // aged tasks are charged as well, so the shares even out afterwards
+  _pass = std::max(_pass, priorityClass->second.pass);
+  priorityClass->second.pass += 1.0 / getShare(priorityClass->first);
+  priorityClass->second.queryPass = std::max(priorityClass->second.queryPass, query->second.pass);
+  query->second.pass += 1.0;
+
+  if (query->second.tasks.empty()) {
+    priorityClass->second.queries.erase(query);
+    if (priorityClass->second.queries.empty())
+      _classes.erase(priorityClass);
+  }
+  return task;
+}
+
+FairSharePriorityScheduler::FairSharePriorityScheduler(int threads) : DynamicPriorityScheduler(threads, false) {
+  // workers use the fair queue, launch them once it exists
+  launchWorkers(threads);
+}
+
+FairSharePriorityScheduler::~FairSharePriorityScheduler() {
+  // workers access the fair queue, stop them before it is destroyed
+  if (_worker_threads.size() > 0)
+    shutdown();
+}
+
+void FairSharePriorityScheduler::setShare(int priority, double share) {
+  std::lock_guard<lock_t> lk(_queueMutex);
+  _fairQueue.setShare(priority, share);
+}
+
+void FairSharePriorityScheduler::setAgingThreshold(FairShareQueue::clock_t::duration threshold) {
+  std::lock_guard<lock_t> lk(_queueMutex);
+  _fairQueue.setAgingThreshold(threshold);
+}
+
+void FairSharePriorityScheduler::pushReady(const std::shared_ptr<Task> &task) {
+  _fairQueue.push(task);
+}
+
+std::shared_ptr<Task> FairSharePriorityScheduler::popReady() {
+  return _fairQueue.pop();
+}
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,103 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_TASKSCHEDULER_FAIRSHAREPRIORITYSCHEDULER_H_
+#define SRC_LIB_TASKSCHEDULER_FAIRSHAREPRIORITYSCHEDULER_H_
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "DynamicPriorityScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Run queue that shares the workers between priority classes in
+ * proportion to their CPU shares and, within a class, equally between
+ * the queries that have ready tasks. A query is identified by its
+ * session, or by its query id if it has none. Every dispatched task
+ * counts as one unit, dynamic parallelization keeps the tasks of large
+ * operations short enough for that.
+ *
+ * Shares are enforced by stride scheduling: a class advances its pass
+ * by 1 / share per task and the class with the lowest pass runs next,
+ * so no class with a share starves. Classes and queries that become
+ * ready again start at the current pass and cannot bank idle time.
+ * Tasks that waited longer than the aging threshold run before all
+ * others, oldest first, which bounds the tail latency of small queries
+ * next to large ones.
+ */
+class FairShareQueue {
+ public:
+  typedef std::chrono::steady_clock clock_t;
+
+  static const double defaultShare;
+
+  /// CPU share of the priority class, classes without one get the defaultShare
+  void setShare(int priority, double share);
+  double getShare(int priority) const;
+  /// Maximum time a task waits before it runs regardless of the shares, 0 disables aging
+  void setAgingThreshold(clock_t::duration threshold);
+
+  void push(const std::shared_ptr<Task> &task);
+  /// Next task to run, nullptr if the queue is empty
+  std::shared_ptr<Task> pop();
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+ private:
+  // session id, or query id for queries without a session
+  typedef std::pair<int, std::string> query_key_t;
+  typedef std::pair<clock_t::time_point, std::shared_ptr<Task>> entry_t;
+
+  struct Query {
+    std::deque<entry_t> tasks;
+    double pass = 0;
+  };
+
+  struct PriorityClass {
+    std::map<query_key_t, Query> queries;
+    double pass = 0;
+    // pass of the query that ran last, where queries that become ready start
+    double queryPass = 0;
+  };
+
+  std::shared_ptr<Task> take(std::map<int, PriorityClass>::iterator priorityClass,
+                             std::map<query_key_t, Query>::iterator query);
+  std::shared_ptr<Task> popAged();
+
+  std::map<int, double> _shares;
+  // only classes with ready tasks
+  std::map<int, PriorityClass> _classes;
+  // pass of the class that ran last, where classes that become ready start
+  double _pass = 0;
+  clock_t::duration _agingThreshold = clock_t::duration::zero();
+  size_t _size = 0;
+};
+
+/*
+ * DynamicPriorityScheduler that runs the ready tasks in the order of a
+ * FairShareQueue instead of strictly by priority.
+ */
+class FairSharePriorityScheduler : public DynamicPriorityScheduler {
+ public:
+  FairSharePriorityScheduler(int threads = getNumberOfCoresOnSystem());
+  virtual ~FairSharePriorityScheduler();
+
+  void setShare(int priority, double share);
+  void setAgingThreshold(FairShareQueue::clock_t::duration threshold);
+
+ protected:
+  virtual void pushReady(const std::shared_ptr<Task> &task);
+  virtual std::shared_ptr<Task> popReady();
+
+ private:
+  FairShareQueue _fairQueue;
+};
+
+} } // namespace hyrise::taskscheduler
+
+#endif  // SRC_LIB_TASKSCHEDULER_FAIRSHAREPRIORITYSCHEDULER_H_
@@ -0,0 +1,44 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "NodeBoundQueue.h"
+#include "NodeBoundQueuesScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+NodeBoundQueue::NodeBoundQueue(int core, unsigned node, NodeBoundQueuesScheduler *scheduler):
+    WSCoreBoundQueue(core, scheduler, false), _node(node), _nodeScheduler(scheduler) {
+  launchThread(_core);
+}
+
+NodeBoundQueue::~NodeBoundQueue() {
+  // the worker calls stealTasks, stop it while this queue is complete
+  if (_thread != nullptr) stopQueue();
+}
+
+std::shared_ptr<Task> NodeBoundQueue::stealTasks() {
+  //check scheduler status
+  if (_scheduler->getSchedulerStatus() != NodeBoundQueuesScheduler::RUN)
+    return nullptr;
+
+  if (auto task = _nodeScheduler->takeFromPool(_node))
+    return task;
+  if (auto task = stealFrom(_nodeScheduler->getQueuesOfNode(_node)))
+    return task;
+
+  // the node ran out of queued tasks, help the other nodes; take single
+  // tasks only, so that as few tasks as possible leave their node
+  const size_t nodes = _nodeScheduler->getNumberOfNodes();
+  for (size_t i = 1; i < nodes; ++i) {
+    const unsigned victim = (_node + i) % nodes;
+    auto task = _nodeScheduler->takeFromPool(victim);
+    if (!task)
+      task = stealFrom(_nodeScheduler->getQueuesOfNode(victim), false);
+    if (task) {
+      task->setActualNode(_node);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+} } // namespace hyrise::taskscheduler
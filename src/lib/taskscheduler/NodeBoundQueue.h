@@ -0,0 +1,33 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include "WSCoreBoundQueue.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+class NodeBoundQueuesScheduler;
+
+/*
+ * Work-stealing queue that knows the NUMA node its core belongs to. An
+ * idle worker takes tasks from the pool of its node, then steals from
+ * the queues of its node. Only if its node has no queued work left, it
+ * turns to the pools and queues of the other nodes.
+ */
+class NodeBoundQueue : public WSCoreBoundQueue {
+  unsigned _node;
+  NodeBoundQueuesScheduler *_nodeScheduler;
+
+protected:
+  std::shared_ptr<Task> stealTasks();
+
+public:
+  NodeBoundQueue(int core, unsigned node, NodeBoundQueuesScheduler *scheduler);
+  virtual ~NodeBoundQueue();
+
+  unsigned getNode() const {
+    return _node;
+  }
+};
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,108 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "NodeBoundQueuesScheduler.h"
+#include "NodeBoundQueue.h"
+#include "SharedScheduler.h"
+
+#include <algorithm>
+
+namespace hyrise {
+namespace taskscheduler {
+
+// register Scheduler at SharedScheduler
+namespace {
+bool registered  =
+    SharedScheduler::registerScheduler<NodeBoundQueuesScheduler>("NodeBoundQueuesScheduler");
+}
+
+NodeBoundQueuesScheduler::NodeBoundQueuesScheduler(const int queues) : WSCoreBoundQueuesScheduler(queues, false), _nextNode(0) {
+  // hwloc reports no node on machines without NUMA
+  const unsigned nodes = std::max(::getNumberOfNodes(getHWTopology()), 1u);
+  for (unsigned i = 0; i < nodes; ++i) {
+    _nodes.emplace_back(new NumaNode());
+  }
+  createQueues(queues);
+  for (unsigned i = 0; i < nodes; ++i) {
+    LOG4CXX_DEBUG(_logger, "Node " << i << " has " << _nodes[i]->queues.size() << " queues");
+  }
+}
+
+NodeBoundQueuesScheduler::~NodeBoundQueuesScheduler() {
+  // workers access the nodes, stop them before the nodes are destroyed
+  _status = TO_STOP;
+  for (auto *queue : _taskQueues) {
+    queue->stopQueue();
+  }
+}
+
+size_t NodeBoundQueuesScheduler::getNumberOfNodes() const {
+  return _nodes.size();
+}
+
+const std::vector<AbstractCoreBoundQueue *> &NodeBoundQueuesScheduler::getQueuesOfNode(unsigned node) const {
+  return _nodes[node]->queues;
+}
+
+std::shared_ptr<Task> NodeBoundQueuesScheduler::takeFromPool(unsigned node) {
+  std::shared_ptr<Task> task;
+  if (_nodes[node]->pool.try_pop(task))
+    return task;
+  return nullptr;
+}
+
+void NodeBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
+  int core = task->getPreferredCore();
+  if (core >= 0 && core < static_cast<int>(_queues)) {
+    // push task to queue that runs on given core
+    task->setActualNode(_nodeOfQueue[core]);
+    _taskQueues[core]->push(task);
+    LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " pushed to queue " << core);
+    return;
+  }
+  if (core != Task::NO_PREFERRED_CORE)
+    // Tried to assign task to core which is not assigned to scheduler; assigned to other core, log warning
+    LOG4CXX_WARN(_logger, "Tried to assign task " << std::hex << (void *)task.get() << std::dec << " to core " << std::to_string(core) << " which is not assigned to scheduler; assigned it to next available node");
+
+  NodeBoundQueue *own = nullptr;
+  WSCoreBoundQueue *current = WSCoreBoundQueue::current();
+  if (current != nullptr && current->getScheduler() == this)
+    own = static_cast<NodeBoundQueue *>(current);
+
+  int node = task->getPreferredNode();
+  if (node < 0 || node >= static_cast<int>(_nodes.size()) || _nodes[node]->queues.empty()) {
+    if (own != nullptr) {
+      node = own->getNode();
+    } else {
+      // round robin on nodes that have queues
+      do {
+        node = _nextNode++ % _nodes.size();
+      } while (_nodes[node]->queues.empty());
+    }
+  }
+  task->setActualNode(node);
+
+  // tasks of a worker for its own node stay on its queue, idle workers of the node steal them
+  if (own != nullptr && static_cast<int>(own->getNode()) == node) {
+    own->push(task);
+    return;
+  }
+  _nodes[node]->pool.push(task);
+  LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " pushed to pool of node " << node);
+  for (auto *queue : _nodes[node]->queues) {
+    if (static_cast<WSCoreBoundQueue *>(queue)->wakeUp())
+      return;
+  }
+  // all workers of the node are busy, idle workers of other nodes may help
+  wakeIdleWorker();
+}
+
+WSCoreBoundQueuesScheduler::task_queue_t *NodeBoundQueuesScheduler::createTaskQueue(int core) {
+  unsigned node = 0;
+  if (_nodes.size() > 1)
+    node = getNodeForCore(AbstractCoreBoundQueue::getSystemCore(core));
+  auto *queue = new NodeBoundQueue(core, node, this);
+  _nodes[node]->queues.push_back(queue);
+  _nodeOfQueue.push_back(node);
+  return queue;
+}
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,63 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "tbb/concurrent_queue.h"
+#include "WSCoreBoundQueuesScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Hierarchical work-stealing scheduler for NUMA systems. The queues are
+ * grouped by the node of the core they are bound to, and each node has a
+ * pool for tasks that may run on any of its cores.
+ *
+ * A task runs on its preferred core if set, otherwise on its preferred
+ * node. Tasks inherit the node their last dependency ran on. Tasks
+ * without a hint stay with the worker that schedules them or are spread
+ * over the nodes. Idle workers steal inside their node first and cross
+ * nodes only once their node ran out of queued tasks.
+ */
+class NodeBoundQueuesScheduler : public WSCoreBoundQueuesScheduler {
+  struct NumaNode {
+    // tasks for any core of the node
+    tbb::concurrent_queue<std::shared_ptr<Task> > pool;
+    std::vector<AbstractCoreBoundQueue *> queues;
+  };
+
+  std::vector<std::unique_ptr<NumaNode> > _nodes;
+  // node of each queue
+  std::vector<unsigned> _nodeOfQueue;
+  // round robin on nodes for tasks without hint
+  std::atomic<size_t> _nextNode;
+
+  /**
+   * push ready task to the queue of its core or the pool of its node
+   */
+  virtual void pushToQueue(std::shared_ptr<Task> task);
+
+  /*
+   * create a new task queue
+   */
+  virtual task_queue_t *createTaskQueue(int core);
+
+public:
+  NodeBoundQueuesScheduler(int queues = getNumberOfCoresOnSystem());
+  virtual ~NodeBoundQueuesScheduler();
+
+  size_t getNumberOfNodes() const;
+
+  /*
+   * queues of the given node
+   */
+  const std::vector<AbstractCoreBoundQueue *> &getQueuesOfNode(unsigned node) const;
+
+  /*
+   * take a task from the pool of the given node, nullptr if it is empty
+   */
+  std::shared_ptr<Task> takeFromPool(unsigned node);
+};
+
+} } // namespace hyrise::taskscheduler
@@ -60,6 +60,8 @@ public:
   virtual size_t determineDynamicCount(size_t maxTaskRunTime) {
     return 1;
   }
+  // called with the result of applyDynamicParallelization before the instances are scheduled
+  virtual void notifyParallelized(const std::vector<task_ptr_t>& instances, size_t dynamicCount) {}
 
 protected:
   std::vector<task_ptr_t> _dependencies;
@@ -84,7 +86,9 @@ protected:
   // sessionId
   int _sessionId;
   // id - equals transaction id
-  int _id;
+  tx::transaction_id_t _id;
+  // id of the query the task belongs to, see RequestParseTask
+  std::string _queryId;
 
   // if true, the DynamicPriorityScheduler will determine the number of instances.
   bool _dynamic = false;
@@ -201,11 +205,11 @@ public:
     this->_priority = priority;
   }
 
-  int getId() const {
+  tx::transaction_id_t getId() const {
     return _id;
   }
 
-  void setId(int id) {
+  void setId(tx::transaction_id_t id) {
     this->_id = id;
 
   }
@@ -219,6 +223,14 @@ public:
     _sessionId = sessionId;
   }
 
+  const std::string& getQueryId() const {
+    return _queryId;
+  }
+
+  void setQueryId(const std::string& queryId) {
+    _queryId = queryId;
+  }
+
   // used in the DynamicPriorityScheduler
   // if true and task is ParallizablePlanOperation the number of instances is determined
   // by an operators determineDynamicCount operation.
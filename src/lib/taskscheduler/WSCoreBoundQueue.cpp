@@ -7,110 +7,181 @@
 
 #include "WSCoreBoundQueue.h"
 
+#include <chrono>
+
 namespace hyrise {
 namespace taskscheduler {
 
-WSCoreBoundQueue::WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler): AbstractCoreBoundQueue() {
+namespace {
+// queue of the worker thread
+thread_local WSCoreBoundQueue *currentQueue = nullptr;
+
+// parked workers look for tasks of other queues at least that often
+const std::chrono::milliseconds parkTimeout(1);
+}
+
+WSCoreBoundQueue::WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler):
+    WSCoreBoundQueue(core, scheduler, true) {
+}
+
+WSCoreBoundQueue::WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler, bool launch):
+    AbstractCoreBoundQueue(), _scheduler(scheduler), _random(core + 1), _inbox(nullptr), _parked(false) {
   _core = core;
-  _scheduler = scheduler;
-  launchThread(_core);
+  if (launch)
+    launchThread(_core);
 }
 
 WSCoreBoundQueue::~WSCoreBoundQueue() {
   if (_thread != nullptr) stopQueue();
 }
 
+WSCoreBoundQueue *WSCoreBoundQueue::current() {
+  return currentQueue;
+}
+
 void WSCoreBoundQueue::executeTask() {
+  currentQueue = this;
+  size_t idleRounds = 0;
   //infinite thread loop
-  while (1) {
-    //block protected by _threadStatusMutex
-    if (_status == TO_STOP)
-      break;
-
-    // lock queue to get task
-    std::unique_lock<lock_t> ul(_queueMutex);
-
-    std::shared_ptr<Task> task;
-    // get task and execute
-    if (_runQueue.size() > 0) {
-      // get first task
-      task = _runQueue.front();
-      _runQueue.pop_front();
-      ul.unlock();
-
-      // no task in runQueue -> try to steal task from other queue, otherwise sleep and wait for new tasks
-    } else {
-      ul.unlock();
-      // try to steal work
-      task = stealTasks();
-      if (!task){
-        ul.lock();
-        //if queue still empty go to sleep and wait until new tasks have been arrived
-        if (_runQueue.size() < 1) {
-          {
-            // if thread is about to stop, break execution loop
-            if(_status != RUN)
-              break;
-            _condition.wait(ul);           
-          }
-        }
+  while (_status != TO_STOP) {
+    std::shared_ptr<Task> task = nextTask();
+    if (!task) {
+      // if thread is about to stop, break execution loop
+      if (_status != RUN)
+        break;
+      // spin a while before going to sleep, tasks often arrive in bursts
+      if (++idleRounds < spinRounds) {
+        std::this_thread::yield();
+      } else {
+        idleRounds = 0;
+        park();
       }
+      continue;
+    }
+    idleRounds = 0;
+    //LOG4CXX_DEBUG(logger, "Started executing task" << std::hex << &task << std::dec << " on core " << _core);
+    // run task
+    (*task)();
+
+    LOG4CXX_DEBUG(logger, "Executed task " << std::hex << &task << std::dec << " on core " << _core);
+    // notify done observers that task is done
+    task->notifyDoneObservers();
+  }
+  currentQueue = nullptr;
+}
+
+std::shared_ptr<Task> WSCoreBoundQueue::nextTask() {
+  Node *node;
+  if (!_runQueue.pop(node)) {
+    Node *inbox = _inbox.exchange(nullptr);
+    if (inbox == nullptr) {
+      return stealTasks();
     }
-    if (task) {
-      //LOG4CXX_DEBUG(logger, "Started executing task" << std::hex << &task << std::dec << " on core " << _core);
-      // run task
-      //std::cout << "Running task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
-      (*task)();
-      //std::cout << "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
-
-      LOG4CXX_DEBUG(logger, "Executed task " << std::hex << &task << std::dec << " on core " << _core);
-      // notify done observers that task is done
-      task->notifyDoneObservers();
+    takeInbox(inbox);
+    if (!_runQueue.pop(node)) {
+      return stealTasks();
     }
   }
+  std::shared_ptr<Task> task = std::move(node->task);
+  delete node;
+  return task;
+}
+
+void WSCoreBoundQueue::takeInbox(Node *inbox) {
+  // the inbox is a stack, reverse it to keep the order of pushing
+  Node *reversed = nullptr;
+  while (inbox != nullptr) {
+    Node *next = inbox->next;
+    inbox->next = reversed;
+    reversed = inbox;
+    inbox = next;
+  }
+  for (; reversed != nullptr; reversed = reversed->next) {
+    _runQueue.push(reversed);
+  }
 }
 
 std::shared_ptr<Task> WSCoreBoundQueue::stealTasks() {
-  std::shared_ptr<Task> task = nullptr;
   //check scheduler status
   WSCoreBoundQueuesScheduler::scheduler_status_t status = _scheduler->getSchedulerStatus();
-  if (status == WSCoreBoundQueuesScheduler::RUN) {
-    auto *queues = _scheduler->getTaskQueues();
-    if (queues != nullptr) {
-      int number_of_queues = queues->size();
-      if(number_of_queues > 1){
-        // steal from the next queue (we only check number_of_queues -1, as we do not have to check the queue taht wants to steal)
-        for (int i = 1; i < number_of_queues; i++) {
-          // we steal relative from the current queue to distribute stealing over queues
-          task = static_cast<WSCoreBoundQueue *>(queues->at((i + _core) % number_of_queues))->stealTask();
-          if (task != nullptr) {
-            //push(task);
-            //std::cout << "Queue " << _core << " stole Task " <<  task->vname() << "; hex " << std::hex << &task << std::dec << " from queue " << i << std::endl;
-            break;
-          }
+  if (status != WSCoreBoundQueuesScheduler::RUN)
+    return nullptr;
+  auto *queues = _scheduler->getTaskQueues();
+  if (queues == nullptr || queues->size() < 2)
+    return nullptr;
+
+  return stealFrom(*queues);
+}
+
+std::shared_ptr<Task> WSCoreBoundQueue::stealFrom(const std::vector<AbstractCoreBoundQueue *> &victims, bool inboxes) {
+  if (victims.empty())
+    return nullptr;
+  // visit all queues starting at a random one, so thieves do not
+  // contend for the same victim
+  const size_t number_of_queues = victims.size();
+  const size_t first = _random() % number_of_queues;
+  for (size_t i = 0; i < number_of_queues; ++i) {
+    auto *victim = static_cast<WSCoreBoundQueue *>(victims[(first + i) % number_of_queues]);
+    if (victim == this)
+      continue;
+    if (auto task = victim->stealTask())
+      return task;
+    // tasks the victim did not take from its inbox yet move to this queue
+    if (inboxes && victim->_status == RUN) {
+      if (Node *inbox = victim->_inbox.exchange(nullptr)) {
+        takeInbox(inbox);
+        Node *node;
+        if (_runQueue.pop(node)) {
+          std::shared_ptr<Task> task = std::move(node->task);
+          delete node;
+          return task;
         }
       }
     }
   }
-  return task;
+  return nullptr;
 }
 
 std::shared_ptr<Task> WSCoreBoundQueue::stealTask() {
-  std::shared_ptr<Task> task = nullptr;
-  // hold queueMutex, to avoid race conditions
-  std::lock_guard<lock_t> lk1(_queueMutex);
+  Node *node;
   // dont steal tasks if thread is about to stop
-  if (_status == RUN && _runQueue.size() >= 1) {
-      task = _runQueue.back();
-      _runQueue.pop_back();
-  }
+  if (_status != RUN || !_runQueue.steal(node))
+    return nullptr;
+  std::shared_ptr<Task> task = std::move(node->task);
+  delete node;
   return task;
 }
 
 void WSCoreBoundQueue::push(std::shared_ptr<Task> task) {
+  Node *node = new Node {std::move(task), nullptr};
+  if (currentQueue == this) {
+    _runQueue.push(node);
+  } else {
+    node->next = _inbox.load();
+    while (!_inbox.compare_exchange_weak(node->next, node)) {}
+  }
+  // idle workers of other queues may steal the task if the owner is busy
+  if (!wakeUp())
+    _scheduler->wakeIdleWorker();
+}
+
+bool WSCoreBoundQueue::wakeUp() {
+  if (!_parked.load())
+    return false;
+  // the worker checks its inbox holding the mutex before it waits
   std::lock_guard<lock_t> lk(_queueMutex);
-  _runQueue.push_back(task);
   _condition.notify_one();
+  return true;
+}
+
+void WSCoreBoundQueue::park() {
+  std::unique_lock<lock_t> ul(_queueMutex);
+  _parked = true;
+  _scheduler->parkedWorkers(1);
+  if (_inbox.load() == nullptr && _status == RUN)
+    _condition.wait_for(ul, parkTimeout);
+  _scheduler->parkedWorkers(-1);
+  _parked = false;
 }
 
 std::vector<std::shared_ptr<Task> > WSCoreBoundQueue::stopQueue() {
@@ -134,11 +205,14 @@ std::vector<std::shared_ptr<Task> > WSCoreBoundQueue::stopQueue() {
 
 std::vector<std::shared_ptr<Task> > WSCoreBoundQueue::emptyQueue() {
   std::vector<std::shared_ptr<Task> > tmp;
-  std::lock_guard<lock_t> lk(_queueMutex);
-  for(auto it = _runQueue.begin(); it != _runQueue.end(); it++)
-    tmp.push_back(*it);
+  // the worker does not run anymore, so this thread may act as owner
+  takeInbox(_inbox.exchange(nullptr));
+  Node *node;
+  while (_runQueue.steal(node)) {
+    tmp.push_back(std::move(node->task));
+    delete node;
+  }
   return tmp;
 }
 
 } } // namespace hyrise::taskscheduler
-
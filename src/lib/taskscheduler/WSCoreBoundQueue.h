@@ -7,23 +7,67 @@
 
 #pragma once
 
-#include <deque>
+#include <atomic>
+#include <random>
 #include "WSCoreBoundQueuesScheduler.h"
 #include "AbstractCoreBoundQueue.h"
+#include "WorkStealingDeque.h"
 
 namespace hyrise {
 namespace taskscheduler {
 
 class WSCoreBoundQueuesScheduler;
 
+/*
+ * Work-stealing queue without locks on the task path. The worker thread
+ * owns a WorkStealingDeque: tasks it schedules itself are pushed to and
+ * popped from the bottom, idle workers of other queues steal from the
+ * top. Tasks pushed by other threads go to a lock-free inbox the worker
+ * moves to its deque, thieves may take a whole inbox, too.
+ *
+ * Idle workers try their own queue and all others, starting at a random
+ * victim, for a number of rounds before they park on the condition
+ * variable. Pushing wakes the parked owner or another parked worker.
+ */
 class WSCoreBoundQueue : public AbstractCoreBoundQueue {
+protected:
+  struct Node {
+    std::shared_ptr<Task> task;
+    Node *next;
+  };
 
-  typedef std::deque<std::shared_ptr<Task> > run_queue_t;
-  run_queue_t _runQueue;
   WSCoreBoundQueuesScheduler * _scheduler;
+  std::minstd_rand _random;
+
+  /*
+   * constructor for subclasses, which launch the thread once they are
+   * constructed themselves
+   */
+  WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler, bool launch);
+
+  /*
+   * called by the worker once its own queue is empty
+   */
+  virtual std::shared_ptr<Task> stealTasks();
+  /*
+   * steal from the given queues, starting at a random one; with inboxes,
+   * the whole inbox of a victim may move to this queue
+   */
+  std::shared_ptr<Task> stealFrom(const std::vector<AbstractCoreBoundQueue *> &victims, bool inboxes = true);
 
 private:
-  std::shared_ptr<Task> stealTasks();
+  WorkStealingDeque<Node *> _runQueue;
+  // Tasks pushed by other threads, a stack taken as a whole
+  std::atomic<Node *> _inbox;
+  std::atomic<bool> _parked;
+
+  // Steal rounds of an idle worker before it parks
+  static const size_t spinRounds = 64;
+
+  std::shared_ptr<Task> nextTask();
+  // Moves the tasks of inbox to the deque in the order of pushing
+  void takeInbox(Node *inbox);
+  void park();
 
 public:
   WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler);
@@ -43,14 +87,27 @@ public:
   std::vector<std::shared_ptr<Task> > stopQueue();
 
   /**
-   * empty queue
+   * empty queue, only once the worker thread stopped
    */
   std::vector<std::shared_ptr<Task> > emptyQueue();
   /*
    * steal Task
    * */
   std::shared_ptr<Task> stealTask();
+
+  /*
+   * wakes the worker if it is parked, returns whether it was
+   */
+  bool wakeUp();
+
+  WSCoreBoundQueuesScheduler *getScheduler() const {
+    return _scheduler;
+  }
+
+  /*
+   * the queue of the calling worker thread or nullptr
+   */
+  static WSCoreBoundQueue *current();
 };
 
 } } // namespace hyrise::taskscheduler
-
@@ -18,8 +18,16 @@ bool registered  =
     SharedScheduler::registerScheduler<WSCoreBoundQueuesScheduler>("WSCoreBoundQueuesScheduler");
 }
 
-WSCoreBoundQueuesScheduler::WSCoreBoundQueuesScheduler(const int queues) : AbstractCoreBoundQueuesScheduler(){
+WSCoreBoundQueuesScheduler::WSCoreBoundQueuesScheduler(const int queues) : WSCoreBoundQueuesScheduler(queues, true) {
+}
+
+WSCoreBoundQueuesScheduler::WSCoreBoundQueuesScheduler(const int queues, bool create) : AbstractCoreBoundQueuesScheduler(), _parkedWorkers(0), _roundRobin(0) {
   _status = START_UP;
+  if (create)
+    createQueues(queues);
+}
+
+void WSCoreBoundQueuesScheduler::createQueues(const int queues) {
   // set _queues to queues after new queues have been created to new tasks to be assigned to new queues
   // lock _queue mutex as queues are manipulated
   std::lock_guard<lock_t> lk(_queuesMutex);
@@ -36,7 +44,6 @@ WSCoreBoundQueuesScheduler::WSCoreBoundQueuesScheduler(const int queues) : Abstr
     _queues = getNumberOfCoresOnSystem();
   }
   _status = RUN;
-
 }
 
 WSCoreBoundQueuesScheduler::~WSCoreBoundQueuesScheduler() {
@@ -52,15 +59,31 @@ WSCoreBoundQueuesScheduler::~WSCoreBoundQueuesScheduler() {
 const std::vector<AbstractCoreBoundQueue *> *WSCoreBoundQueuesScheduler::getTaskQueues() {
    // check if task scheduler is about to change structure of scheduler (change number of queues); if yes, return nullptr
 
-     if (this->_status == AbstractCoreBoundQueuesScheduler::RESIZING
+     if (this->_status == AbstractCoreBoundQueuesScheduler::START_UP
+         || this->_status == AbstractCoreBoundQueuesScheduler::RESIZING
          || this->_status == AbstractCoreBoundQueuesScheduler::TO_STOP
          || this->_status == AbstractCoreBoundQueuesScheduler::STOPPED)
        return nullptr;
-   // return const reference to task queues
-   std::lock_guard<lock_t> lk(this->_queuesMutex);
+   // queues are only changed while starting, resizing or stopping, no need to lock
    return &this->_taskQueues;
  }
 
+void WSCoreBoundQueuesScheduler::parkedWorkers(int delta) {
+  _parkedWorkers += delta;
+}
+
+void WSCoreBoundQueuesScheduler::wakeIdleWorker() {
+  if (_parkedWorkers.load() == 0)
+    return;
+  auto *queues = getTaskQueues();
+  if (queues == nullptr)
+    return;
+  for (auto *queue : *queues) {
+    if (static_cast<WSCoreBoundQueue *>(queue)->wakeUp())
+      return;
+  }
+}
+
 void WSCoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
     int core = task->getPreferredCore();
     if (core >= 0 && core < static_cast<int>(this->_queues)) {
@@ -71,13 +94,13 @@ void WSCoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
       if (core < Task::NO_PREFERRED_CORE || core >= static_cast<int>(this->_queues))
         // Tried to assign task to core which is not assigned to scheduler; assigned to other core, log warning
         LOG4CXX_WARN(this->_logger, "Tried to assign task " << std::hex << (void *)task.get() << std::dec << " to core " << std::to_string(core) << " which is not assigned to scheduler; assigned it to next available core");
-      // push task to next queue
-      {
-        std::lock_guard<lock_t> lk2(this->_queuesMutex);
-        this->_taskQueues[this->_nextQueue]->push(task);
-        //std::cout << "Task " <<  task->vname() << "; hex " << std::hex << &task << std::dec << " pushed to queue " << this->_nextQueue << std::endl;
+      // tasks scheduled by a worker stay on its queue, idle workers steal them
+      WSCoreBoundQueue *own = WSCoreBoundQueue::current();
+      if (own != nullptr && own->getScheduler() == this) {
+        own->push(task);
+      } else {
         //round robin on cores
-        this->_nextQueue = (this->_nextQueue + 1) % this->_queues;
+        this->_taskQueues[_roundRobin++ % this->_queues]->push(task);
       }
     }
   }
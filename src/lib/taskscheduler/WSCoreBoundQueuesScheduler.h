@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "AbstractCoreBoundQueuesScheduler.h"
 #include "AbstractCoreBoundQueue.h"
 
@@ -14,7 +15,12 @@ namespace hyrise {
 namespace taskscheduler {
 
 class WSCoreBoundQueuesScheduler : public AbstractCoreBoundQueuesScheduler {
+  // number of workers waiting on their condition variable
+  std::atomic<int> _parkedWorkers;
+  // round robin for tasks without preferred core
+  std::atomic<size_t> _roundRobin;
 
+protected:
   /**
    * push ready task to the next queue
    */
@@ -25,6 +31,15 @@ class WSCoreBoundQueuesScheduler : public AbstractCoreBoundQueuesScheduler {
    */
   virtual WSCoreBoundQueuesScheduler::task_queue_t *createTaskQueue(int core);
 
+  /*
+   * for subclasses, which call createQueues once they are constructed
+   */
+  WSCoreBoundQueuesScheduler(int queues, bool create);
+
+  /*
+   * create the given number of queues, at most one per core, and start running
+   */
+  void createQueues(int queues);
 
 public:
   WSCoreBoundQueuesScheduler(int queues = getNumberOfCoresOnSystem());
@@ -32,6 +47,16 @@ public:
 
   const std::vector<AbstractCoreBoundQueue *> *getTaskQueues();
 
+  /*
+   * called by workers when they park (1) and wake up again (-1)
+   */
+  void parkedWorkers(int delta);
+
+  /*
+   * wake a parked worker, if any, to steal newly pushed tasks
+   */
+  void wakeIdleWorker();
+
 };
 
 } } // namespace hyrise::taskscheduler
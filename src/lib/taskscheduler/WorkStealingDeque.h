@@ -0,0 +1,134 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Lock-free work-stealing deque after Chase and Lev ("Dynamic Circular
+ * Work-Stealing Deque", SPAA 2005) with the memory orders of Le et al.
+ * ("Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP
+ * 2013). The owning thread pushes and pops at the bottom, any other
+ * thread steals from the top; only the last element is contended, the
+ * owner and a thief then race for it with a CAS on top.
+ *
+ * T has to be a pointer. The buffer grows when full; replaced buffers
+ * may still be read by thieves and are freed with the deque.
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  explicit WorkStealingDeque(size_t capacity = 1024) : _top(0), _bottom(0) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    _buffers.emplace_back(new Buffer(size));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /// Owner only
+  void push(T item) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top = _top.load(std::memory_order_acquire);
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+      buffer = grow(buffer, top, bottom);
+    }
+    buffer->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /// Owner only, returns false if the deque is empty
+  bool pop(T& item) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    item = buffer->get(bottom);
+    if (top == bottom) {
+      // The last element, thieves may take it meanwhile
+      const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  /// Any thread, returns false if the deque is empty or another thread
+  /// took the element first
+  bool steal(T& item) {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return false;
+    }
+    Buffer* buffer = _buffer.load(std::memory_order_acquire);
+    item = buffer->get(top);
+    return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+
+  /// Approximate number of elements
+  size_t size() const {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top = _top.load(std::memory_order_relaxed);
+    return bottom > top ? bottom - top : 0;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+ private:
+  struct Buffer {
+    const size_t mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+
+    explicit Buffer(size_t size) : mask(size - 1), items(new std::atomic<T>[size]) {}
+
+    T get(int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, T item) {
+      items[index & mask].store(item, std::memory_order_relaxed);
+    }
+  };
+
+  Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    _buffers.emplace_back(new Buffer((buffer->mask + 1) * 2));
+    Buffer* grown = _buffers.back().get();
+    for (int64_t i = top; i < bottom; ++i) {
+      grown->put(i, buffer->get(i));
+    }
+    _buffer.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  // Keep thieves and owner on different cache lines; no alignas, the
+  // deque is allocated with plain new before C++17
+  std::atomic<int64_t> _top;
+  char _padding[64 - sizeof(std::atomic<int64_t>)];
+  std::atomic<int64_t> _bottom;
+  std::atomic<Buffer*> _buffer;
+  // All buffers ever used, changed by the owner only
+  std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+} } // namespace hyrise::taskscheduler